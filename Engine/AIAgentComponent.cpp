@@ -63,11 +63,16 @@ void AIAgentComponent::ShootAtPlayer(float deltaTime)
 	{
 		mCurrentShotTimer = 0;
 
-		auto go = mAgentProjectiles->GetGameObject("Player", AI_PROJECTILE_DAMAGE);
+		static const TagID playerTag = TagTable::Instance().Intern("Player");
+		auto go = mAgentProjectiles->GetGameObject(playerTag, AI_PROJECTILE_DAMAGE);
+		if (go == nullptr) // Pool is empty, try again next interval
+			return;
+
 		Vec2 dir = mTargetTransform->GetWorldPosition() - mAgentTransform->GetWorldPosition();
 		dir.Normalize();
 
 		go->GetComponent<TransformComponent>()->SetWorldPosition(mAgentTransform->GetWorldPosition() + (dir * 10));
+		go->GetComponent<TransformComponent>()->ResetInterpolation(); // Don't draw it sliding out of the pool
 		go->GetComponent<RigidBodyComponent>()->ApplyForce(dir * AI_PROJECTILE_SPEED);
 
 		Audio::Instance().PlaySoundEffect("GunShot");
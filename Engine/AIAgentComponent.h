@@ -18,6 +18,7 @@ public:
 	~AIAgentComponent();
 
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderGamePlay; }
 
 	void SetupPatrolling(float patrolTime, AIAgentPatrolDirection startDir, float idleTime);
 	void SetupShooting(ProjectileManagerComponent* projectileMan, TransformComponent* targetTransform, float range, float shotInterval);
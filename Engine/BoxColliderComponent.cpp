@@ -25,3 +25,9 @@ void BoxColliderComponent::SetBox(float hw, float hh)
 	Normals[2].Set(0.0f, 1.0f);
 	Normals[3].Set(-1.0f, 0.0f);
 }
+
+bool BoxColliderComponent::IsAxisAligned()
+{
+	Mat2 orientation = mRigidyBodyComponent->GetOrientationMatrix();
+	return orientation.m00 == 1.0f && orientation.m01 == 0.0f && orientation.m10 == 0.0f && orientation.m11 == 1.0f;
+}
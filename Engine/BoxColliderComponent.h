@@ -8,6 +8,12 @@ public:
 	BoxColliderComponent(TransformComponent* trans, RigidBodyComponent* rb);
 	~BoxColliderComponent();
 
+	virtual ColliderType GetType(void) const override { return ColliderType::eBox; }
+
 	void SetBox(float hw, float hh);
+
+	float GetHalfWidth() { return mHalfWidth; }
+	float GetHalfHeight() { return mHalfHeight; }
+	bool IsAxisAligned(); // True if the box hasn't been rotated, so the cheaper axis aligned routines can be used
 };
 
@@ -37,4 +37,10 @@ Rect CircleColliderComponent::GetRect()
 	r.Centre = Vec2(pos.x + (mRadius / 2), pos.y + (mRadius / 2));
 
 	return r;
+}
+
+AABB CircleColliderComponent::GetAABB()
+{
+	Vec2 pos = mTransformComponent->GetWorldPosition();
+	return AABB(Vec2(pos.x - mRadius, pos.y - mRadius), Vec2(pos.x + mRadius, pos.y + mRadius));
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
 	virtual ColliderType GetType(void) const override { return ColliderType::eCircle; }
 	virtual void ComputeMass(float density) override;
 	virtual Rect GetRect() override;
+	virtual AABB GetAABB() override;
 
 	virtual Vec2 GetCentre() override { return Vec2(mTransformComponent->GetWorldPosition().x + (mRadius/2), mTransformComponent->GetWorldPosition().y + (mRadius / 2)); }
 
@@ -15,21 +15,19 @@ public:
 	virtual ColliderType GetType(void) const = 0;
 	virtual void ComputeMass(float density) = 0;
 	virtual Rect GetRect() = 0;
-
-	void SetPreviousRect(Rect r) { mPreviousRect = r; }
-	Rect GetPreviousRect() { return mPreviousRect; }
+	virtual AABB GetAABB() = 0; // World space bounds used by the broadphase
 
 	virtual Vec2 GetCentre() = 0;
 
-	int								CentreGridSquare;
-	int								LeftGridSquare;
-	int								RightGridSquare;
-	int								BottomGridSquare;
-	int								TopGridSquare;
+	// Bitmask of the CollisionLayers this collider is in. Set before the collider is added to a scene
+	void SetLayerMask(unsigned int layerMask) { mLayerMask = layerMask; }
+	unsigned int GetLayerMask() const { return mLayerMask; }
+
+	int								BroadphaseProxy = -1;
 
 protected:
 	TransformComponent*				mTransformComponent;
 	RigidBodyComponent*				mRigidyBodyComponent;
-	Rect							mPreviousRect;
+	unsigned int					mLayerMask = 1 << eLayerDefault;
 };
 
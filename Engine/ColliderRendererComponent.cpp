@@ -22,11 +22,12 @@ void ColliderRendererComponent::Draw(ICamera* cam)
 {
 	switch (_colliderType)
 	{
+		case ColliderType::eBox:
 		case ColliderType::ePolygon:
 			PolygonColliderComponent* col = reinterpret_cast<PolygonColliderComponent *>(_collider);
 			for (int i = 0; i < col->VertexCount - 1; i++)
 			{
-				cam->DrawLine(GetTransform()->GetWorldPosition() + col->Vertices[i], GetTransform()->GetWorldPosition() + col->Vertices[i + 1]);
+				cam->DrawLine(GetTransform()->GetRenderPosition() + col->Vertices[i], GetTransform()->GetRenderPosition() + col->Vertices[i + 1]);
 			}
 			break;
 	}
@@ -1,60 +1,135 @@
 #include "Collision.h"
 
+#include <cstring>
+
+static constexpr int POLYGON_VERTEX_FEATURE = 1 << 30; // Set when a circle hits the corner of a polygon rather than a face
+static constexpr int POLYGON_FLIP_FEATURE = 1 << 29; // Set when the reference face of a polygon collision belongs to B
+
 
 Collision::~Collision()
 {
 }
 
-void Collision::CheckForCollision()
+bool Collision::HasSameContacts(const Collision & other) const
 {
-	if (mColliderA->GetType() == ColliderType::eCircle && mColliderB->GetType() == ColliderType::eCircle) // Circle to circle
+	// Compared as bits so a difference in the last place, or in the sign of a zero, still counts
+	if (mColliderA != other.mColliderA || mColliderB != other.mColliderB || mContactCount != other.mContactCount
+		|| memcmp(&mPenetration, &other.mPenetration, sizeof(float)) != 0 || memcmp(&mNormal, &other.mNormal, sizeof(Vec2)) != 0)
 	{
-		CircletoCircleCollision();
+		return false;
 	}
-	else if (mColliderA->GetType() == ColliderType::eCircle && mColliderB->GetType() == ColliderType::ePolygon) // Circle to polygon
-	{
-		CircleToPolygonCollision();
-	}
-	else if (mColliderA->GetType() == ColliderType::ePolygon && mColliderB->GetType() == ColliderType::eCircle) // Polygon to circle
+
+	for (int i = 0; i < mContactCount; i++)
 	{
-		PolygonToCircleCollision();
+		if (memcmp(&mContacts[i].position, &other.mContacts[i].position, sizeof(Vec2)) != 0 || mContacts[i].feature != other.mContacts[i].feature)
+			return false;
 	}
-	else if (mColliderA->GetType() == ColliderType::ePolygon && mColliderB->GetType() == ColliderType::ePolygon) // Polygon to polygon
+
+	return true;
+}
+
+const Collision::CollisionFunction Collision::DispatchTable[ColliderType::eColliderTypeCount][ColliderType::eColliderTypeCount] =
+{
+	//						B: eCircle								B: ePolygon								B: eBox
+	/* A: eCircle */		{ &Collision::CircletoCircleCollision,	&Collision::CircleToPolygonCollision,	&Collision::CircleToBoxCollision },
+	/* A: ePolygon */		{ &Collision::PolygonToCircleCollision,	&Collision::PolygonToPolygonCollision,	&Collision::PolygonToPolygonCollision },
+	/* A: eBox */			{ &Collision::BoxToCircleCollision,		&Collision::PolygonToPolygonCollision,	&Collision::BoxToBoxCollision },
+};
+
+void Collision::CheckForCollision()
+{
+	mContactCount = 0;
+	(this->*DispatchTable[mColliderA->GetType()][mColliderB->GetType()])();
+}
+
+void Collision::WarmStartFrom(const Collision & previous)
+{
+	// Contacts generated by the same features are treated as the same contact, so they keep the impulse they built up last step
+	for (int i = 0; i < mContactCount; ++i)
 	{
-		PolygonToPolygonCollision();
+		for (int j = 0; j < previous.mContactCount; ++j)
+		{
+			if (mContacts[i].feature == previous.mContacts[j].feature)
+			{
+				mContacts[i].normalImpulse = previous.mContacts[j].normalImpulse;
+				mContacts[i].tangentImpulse = previous.mContacts[j].tangentImpulse;
+				break;
+			}
+		}
 	}
 }
 
 void Collision::PrepareToSolve(float deltaTime)
 {
+	RigidBodyComponent* rbA = mColliderA->GetRigidbodyComponent();
+	RigidBodyComponent* rbB = mColliderB->GetRigidbodyComponent();
+
 	// Calculate average restitution
-	mMixedRestitution = std::min(mColliderA->GetRigidbodyComponent()->GetRestitution(), mColliderB->GetRigidbodyComponent()->GetRestitution());
+	mMixedRestitution = std::min(rbA->GetRestitution(), rbB->GetRestitution());
 
 	// Calculate static and dynamic friction
-	mMixedStaticFriction = std::sqrt(mColliderA->GetRigidbodyComponent()->GetStaticFriction() * mColliderB->GetRigidbodyComponent()->GetStaticFriction());
-	mMixedDynamicFriction = std::sqrt(mColliderA->GetRigidbodyComponent()->GetDynamicFriction() * mColliderB->GetRigidbodyComponent()->GetDynamicFriction());
+	mMixedStaticFriction = std::sqrt(rbA->GetStaticFriction() * rbB->GetStaticFriction());
+	mMixedDynamicFriction = std::sqrt(rbA->GetDynamicFriction() * rbB->GetDynamicFriction());
+
+	mTangent = Cross(mNormal, 1.0f);
 
 	for (int i = 0; i < mContactCount; ++i)
 	{
+		ContactPoint& contact = mContacts[i];
+
 		// Calculate radii from COM to contact
-		Vec2 ra = mContacts[i] - mColliderA->GetTransformComponent()->GetWorldPosition();
-		Vec2 rb = mContacts[i] - mColliderB->GetTransformComponent()->GetWorldPosition();
+		contact.radiiA = contact.position - mColliderA->GetTransformComponent()->GetWorldPosition();
+		contact.radiiB = contact.position - mColliderB->GetTransformComponent()->GetWorldPosition();
 
-		Vec2 rv = mColliderB->GetRigidbodyComponent()->GetVelocity() + Cross(mColliderB->GetRigidbodyComponent()->GetAngularVelocity(), rb) -
-			mColliderA->GetRigidbodyComponent()->GetVelocity() - Cross(mColliderA->GetRigidbodyComponent()->GetAngularVelocity(), ra);
+		float radiiACrossN = Cross(contact.radiiA, mNormal);
+		float radiiBCrossN = Cross(contact.radiiB, mNormal);
+		float normalMassSum = rbA->GetInverseMass() + rbB->GetInverseMass() +
+			Sqr(radiiACrossN) * rbA->GetInverseIntertia() + Sqr(radiiBCrossN) * rbB->GetInverseIntertia();
+		contact.normalMass = normalMassSum > 0.0f ? 1.0f / normalMassSum : 0.0f;
+
+		float radiiACrossT = Cross(contact.radiiA, mTangent);
+		float radiiBCrossT = Cross(contact.radiiB, mTangent);
+		float tangentMassSum = rbA->GetInverseMass() + rbB->GetInverseMass() +
+			Sqr(radiiACrossT) * rbA->GetInverseIntertia() + Sqr(radiiBCrossT) * rbB->GetInverseIntertia();
+		contact.tangentMass = tangentMassSum > 0.0f ? 1.0f / tangentMassSum : 0.0f;
+
+		Vec2 rv = rbB->GetVelocity() + Cross(rbB->GetAngularVelocity(), contact.radiiB) -
+			rbA->GetVelocity() - Cross(rbA->GetAngularVelocity(), contact.radiiA);
 
 		// Determine if we should perform a resting collision or not
 		// The idea is if the only thing moving this object is gravity,
 		// then the collision should be performed without any restitution
+		float contactVelocity = Dot(rv, mNormal);
 		if (rv.LenSqr() < (deltaTime * GRAVITY_VECTOR).LenSqr() + EPSILON)
-			mMixedRestitution = 0.0f;
+		{
+			contact.velocityBias = 0.0f;
+			contact.friction = mMixedStaticFriction;
+		}
+		else
+		{
+			contact.velocityBias = contactVelocity < 0.0f ? -mMixedRestitution * contactVelocity : 0.0f;
+			contact.friction = mMixedDynamicFriction;
+		}
+	}
+}
+
+void Collision::WarmStart()
+{
+	for (int i = 0; i < mContactCount; ++i)
+	{
+		Vec2 impulse = mNormal * mContacts[i].normalImpulse + mTangent * mContacts[i].tangentImpulse;
+		mColliderA->GetRigidbodyComponent()->ApplyImpulse(-impulse, mContacts[i].radiiA);
+		mColliderB->GetRigidbodyComponent()->ApplyImpulse(impulse, mContacts[i].radiiB);
 	}
 }
 
 void Collision::ResolveCollision()
 {
+	RigidBodyComponent* rbA = mColliderA->GetRigidbodyComponent();
+	RigidBodyComponent* rbB = mColliderB->GetRigidbodyComponent();
+
 	// Early out and positional correct if both objects have infinite mass
-	if (Equal(mColliderA->GetRigidbodyComponent()->GetInverseMass() + mColliderB->GetRigidbodyComponent()->GetInverseMass(), 0))
+	if (Equal(rbA->GetInverseMass() + rbB->GetInverseMass(), 0))
 	{
 		NullVelocities();
 		return;
@@ -62,62 +137,43 @@ void Collision::ResolveCollision()
 
 	for (int i = 0; i < mContactCount; ++i)
 	{
-		// Calculate radii from positions to contact
-		Vec2 radiiA = mContacts[i] - mColliderA->GetTransformComponent()->GetWorldPosition();
-		Vec2 radiiB = mContacts[i] - mColliderB->GetTransformComponent()->GetWorldPosition();
+		ContactPoint& contact = mContacts[i];
+
+		// Friction impulse. Solved first as it is clamped by the normal impulse, which is the more important constraint
+		Vec2 relativeVelocity = rbB->GetVelocity() + Cross(rbB->GetAngularVelocity(), contact.radiiB) -
+			rbA->GetVelocity() - Cross(rbA->GetAngularVelocity(), contact.radiiA);
+
+		float tangentImpulse = -Dot(relativeVelocity, mTangent) * contact.tangentMass;
+
+		// Coulomb's law. Clamp the accumulated impulse rather than this iteration's impulse so earlier iterations can be undone
+		float maxFriction = contact.friction * contact.normalImpulse;
+		float newTangentImpulse = Clamp(-maxFriction, maxFriction, contact.tangentImpulse + tangentImpulse);
+		tangentImpulse = newTangentImpulse - contact.tangentImpulse;
+		contact.tangentImpulse = newTangentImpulse;
+
+		// Apply friction impulse
+		rbA->ApplyImpulse(-mTangent * tangentImpulse, contact.radiiA);
+		rbB->ApplyImpulse(mTangent * tangentImpulse, contact.radiiB);
 
 		// Calculate relative velocity
-		Vec2 relativeVelocity = mColliderB->GetRigidbodyComponent()->GetVelocity() + Cross(mColliderB->GetRigidbodyComponent()->GetAngularVelocity(), radiiB) -
-			mColliderA->GetRigidbodyComponent()->GetVelocity() - Cross(mColliderA->GetRigidbodyComponent()->GetAngularVelocity(), radiiA);
+		relativeVelocity = rbB->GetVelocity() + Cross(rbB->GetAngularVelocity(), contact.radiiB) -
+			rbA->GetVelocity() - Cross(rbA->GetAngularVelocity(), contact.radiiA);
 
 		// Relative velocity along the normal
 		float contactVelocity = Dot(relativeVelocity, mNormal);
 
-		// Do not resolve if velocities are separating
-		if (contactVelocity > 0)
-			return;
-
-		float radiiACrossN = Cross(radiiA, mNormal);
-		float radiiBCrossN = Cross(radiiB, mNormal);
-		float inverseMassSum = mColliderA->GetRigidbodyComponent()->GetInverseMass() + mColliderB->GetRigidbodyComponent()->GetInverseMass() + 
-			Sqr(radiiACrossN) * mColliderA->GetRigidbodyComponent()->GetInverseIntertia() + Sqr(radiiBCrossN) * mColliderB->GetRigidbodyComponent()->GetInverseIntertia();
-
 		// Calculate impulse scalar
-		float impulseScalar = -(1.0f + mMixedRestitution) * contactVelocity;
-		impulseScalar /= inverseMassSum;
-		impulseScalar /= (float)mContactCount;
+		float impulseScalar = -(contactVelocity - contact.velocityBias) * contact.normalMass;
+
+		// The accumulated impulse can only ever push the colliders apart
+		float newNormalImpulse = std::max(contact.normalImpulse + impulseScalar, 0.0f);
+		impulseScalar = newNormalImpulse - contact.normalImpulse;
+		contact.normalImpulse = newNormalImpulse;
 
 		// Apply impulse
 		Vec2 impulse = mNormal * impulseScalar;
-		mColliderA->GetRigidbodyComponent()->ApplyImpulse(-impulse, radiiA);
-		mColliderB->GetRigidbodyComponent()->ApplyImpulse(impulse, radiiB);
-
-		// Friction impulse
-		relativeVelocity = mColliderB->GetRigidbodyComponent()->GetVelocity() + Cross(mColliderB->GetRigidbodyComponent()->GetAngularVelocity(), radiiB) -
-			mColliderA->GetRigidbodyComponent()->GetVelocity() - Cross(mColliderA->GetRigidbodyComponent()->GetAngularVelocity(), radiiA);
-
-		Vec2 t = relativeVelocity - (mNormal * Dot(relativeVelocity, mNormal));
-		t.Normalize();
-
-		// ImpulseScalar tangent magnitude
-		float impulseScalarTangentMagnitude = -Dot(relativeVelocity, t);
-		impulseScalarTangentMagnitude /= inverseMassSum;
-		impulseScalarTangentMagnitude /= (float)mContactCount;
-
-		// Don't apply tiny friction impulses
-		if (Equal(impulseScalarTangentMagnitude, 0.0f))
-			return;
-
-		// Coulomb's law
-		Vec2 tangentImpulse;
-		if (std::abs(impulseScalarTangentMagnitude) < impulseScalar * mMixedStaticFriction)
-			tangentImpulse = t * impulseScalarTangentMagnitude;
-		else
-			tangentImpulse = t * -impulseScalar * mMixedDynamicFriction;
-
-		// Apply friction impulse
-		mColliderA->GetRigidbodyComponent()->ApplyImpulse(-tangentImpulse, radiiA);
-		mColliderB->GetRigidbodyComponent()->ApplyImpulse(tangentImpulse, radiiB);
+		rbA->ApplyImpulse(-impulse, contact.radiiA);
+		rbB->ApplyImpulse(impulse, contact.radiiB);
 	}
 }
 
@@ -139,8 +195,8 @@ void Collision::NullVelocities()
 
 void Collision::CircletoCircleCollision()
 {
-	CircleColliderComponent *A = reinterpret_cast<CircleColliderComponent *>(mColliderA);
-	CircleColliderComponent *B = reinterpret_cast<CircleColliderComponent *>(mColliderB);
+	CircleColliderComponent *A = static_cast<CircleColliderComponent *>(mColliderA);
+	CircleColliderComponent *B = static_cast<CircleColliderComponent *>(mColliderB);
 
 	// Calculate translational vector, which is normal
 	mNormal = B->GetTransformComponent()->GetWorldPosition() - A->GetTransformComponent()->GetWorldPosition();
@@ -163,20 +219,22 @@ void Collision::CircletoCircleCollision()
 	{
 		mPenetration = A->GetRadius();
 		mNormal = Vec2(1, 0);
-		mContacts[0] = A->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].position = A->GetTransformComponent()->GetWorldPosition();
 	}
 	else
 	{
 		mPenetration = radius - distance;
 		mNormal = mNormal / distance; // Faster than using Normalized since we already performed sqrt
-		mContacts[0] = mNormal * A->GetRadius() + A->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].position = mNormal * A->GetRadius() + A->GetTransformComponent()->GetWorldPosition();
 	}
+
+	mContacts[0].feature = 0;
 }
 
 void Collision::CircleToPolygonCollision()
 {
-	CircleColliderComponent *A = reinterpret_cast<CircleColliderComponent *>(mColliderA);
-	PolygonColliderComponent *B = reinterpret_cast<PolygonColliderComponent *>(mColliderB);
+	CircleColliderComponent *A = static_cast<CircleColliderComponent *>(mColliderA);
+	PolygonColliderComponent *B = static_cast<PolygonColliderComponent *>(mColliderB);
 
 	mContactCount = 0;
 
@@ -212,7 +270,8 @@ void Collision::CircleToPolygonCollision()
 	{
 		mContactCount = 1;
 		mNormal = -(B->GetRigidbodyComponent()->GetOrientationMatrix() * B->Normals[faceNormal]);
-		mContacts[0] = mNormal * A->GetRadius() + mColliderA->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].position = mNormal * A->GetRadius() + mColliderA->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].feature = faceNormal;
 		mPenetration = A->GetRadius();
 		return;
 	}
@@ -234,7 +293,8 @@ void Collision::CircleToPolygonCollision()
 		n.Normalize();
 		mNormal = n;
 		vertex1 = B->GetRigidbodyComponent()->GetOrientationMatrix() * vertex1 + mColliderB->GetTransformComponent()->GetWorldPosition();
-		mContacts[0] = vertex1;
+		mContacts[0].position = vertex1;
+		mContacts[0].feature = POLYGON_VERTEX_FEATURE | faceNormal;
 	}
 	else if (dot2 <= 0.0f) // Closest to vertex2
 	{
@@ -244,7 +304,8 @@ void Collision::CircleToPolygonCollision()
 		mContactCount = 1;
 		Vec2 n = vertex2 - center;
 		vertex2 = B->GetRigidbodyComponent()->GetOrientationMatrix() * vertex2 + mColliderB->GetTransformComponent()->GetWorldPosition();
-		mContacts[0] = vertex2;
+		mContacts[0].position = vertex2;
+		mContacts[0].feature = POLYGON_VERTEX_FEATURE | index2;
 		n = B->GetRigidbodyComponent()->GetOrientationMatrix() * n;
 		n.Normalize();
 		mNormal = n;
@@ -257,7 +318,8 @@ void Collision::CircleToPolygonCollision()
 
 		n = B->GetRigidbodyComponent()->GetOrientationMatrix() * n;
 		mNormal = -n;
-		mContacts[0] = mNormal * A->GetRadius() + mColliderA->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].position = mNormal * A->GetRadius() + mColliderA->GetTransformComponent()->GetWorldPosition();
+		mContacts[0].feature = faceNormal;
 		mContactCount = 1;
 	}
 }
@@ -274,8 +336,8 @@ void Collision::PolygonToCircleCollision()
 
 void Collision::PolygonToPolygonCollision()
 {
-	PolygonColliderComponent *A = reinterpret_cast<PolygonColliderComponent *>(mColliderA);
-	PolygonColliderComponent *B = reinterpret_cast<PolygonColliderComponent *>(mColliderB);
+	PolygonColliderComponent *A = static_cast<PolygonColliderComponent *>(mColliderA);
+	PolygonColliderComponent *B = static_cast<PolygonColliderComponent *>(mColliderB);
 	mContactCount = 0;
 
 	// Check for a separating axis with A's face planes
@@ -315,7 +377,10 @@ void Collision::PolygonToPolygonCollision()
 
 	// World space incident face
 	Vec2 incidentFace[2];
-	FindIncidentFace(incidentFace, RefPoly, IncPoly, referenceIndex);
+	int incidentIndex = FindIncidentFace(incidentFace, RefPoly, IncPoly, referenceIndex);
+
+	// Reference face, incident face and which side of A the reference face belongs to identify the contact
+	int feature = (flip ? POLYGON_FLIP_FEATURE : 0) | (referenceIndex << 16) | (incidentIndex << 8);
 
 	// Setup reference face vertices
 	Vec2 v1 = RefPoly->Vertices[referenceIndex];
@@ -352,7 +417,8 @@ void Collision::PolygonToPolygonCollision()
 	float separation = Dot(refFaceNormal, incidentFace[0]) - refC;
 	if (separation <= 0.0f)
 	{
-		mContacts[cp] = incidentFace[0];
+		mContacts[cp].position = incidentFace[0];
+		mContacts[cp].feature = feature | 0;
 		mPenetration = -separation;
 		++cp;
 	}
@@ -362,7 +428,8 @@ void Collision::PolygonToPolygonCollision()
 	separation = Dot(refFaceNormal, incidentFace[1]) - refC;
 	if (separation <= 0.0f)
 	{
-		mContacts[cp] = incidentFace[1];
+		mContacts[cp].position = incidentFace[1];
+		mContacts[cp].feature = feature | 1;
 
 		mPenetration += -separation;
 		++cp;
@@ -374,6 +441,159 @@ void Collision::PolygonToPolygonCollision()
 	mContactCount = cp;
 }
 
+void Collision::CircleToBoxCollision()
+{
+	if (static_cast<BoxColliderComponent *>(mColliderB)->IsAxisAligned())
+		CircleToAxisAlignedBoxCollision();
+	else
+		CircleToPolygonCollision();
+}
+
+void Collision::BoxToCircleCollision()
+{
+	// Same as PolygonToCircleCollision, the circle becomes A
+	ColliderComponent* cC = mColliderA;
+	mColliderA = mColliderB;
+	mColliderB = cC;
+
+	CircleToBoxCollision();
+}
+
+void Collision::BoxToBoxCollision()
+{
+	if (static_cast<BoxColliderComponent *>(mColliderA)->IsAxisAligned() && static_cast<BoxColliderComponent *>(mColliderB)->IsAxisAligned())
+		AxisAlignedBoxToBoxCollision();
+	else
+		PolygonToPolygonCollision();
+}
+
+void Collision::CircleToAxisAlignedBoxCollision()
+{
+	CircleColliderComponent *A = static_cast<CircleColliderComponent *>(mColliderA);
+	BoxColliderComponent *B = static_cast<BoxColliderComponent *>(mColliderB);
+
+	mContactCount = 0;
+
+	float radius = A->GetRadius();
+	Vec2 halfExtents(B->GetHalfWidth(), B->GetHalfHeight());
+	Vec2 circleCentre = A->GetTransformComponent()->GetWorldPosition();
+	Vec2 boxCentre = B->GetTransformComponent()->GetWorldPosition();
+
+	// Circle centre relative to the box, and the closest point to it on or in the box
+	Vec2 centre = circleCentre - boxCentre;
+	Vec2 closest(Clamp(-halfExtents.x, halfExtents.x, centre.x), Clamp(-halfExtents.y, halfExtents.y, centre.y));
+
+	bool clampedX = closest.x != centre.x;
+	bool clampedY = closest.y != centre.y;
+
+	// Features and normals match the polygon routine so warm starting carries over if the box starts or stops rotating.
+	// Faces are numbered bottom, right, top, left as in BoxColliderComponent::SetBox
+	if (!clampedX && !clampedY)
+	{
+		// Centre is inside the box. Push out through the nearest face
+		float separations[4] = { -centre.y - halfExtents.y, centre.x - halfExtents.x, centre.y - halfExtents.y, -centre.x - halfExtents.x };
+		int face = 0;
+		for (int i = 1; i < 4; ++i)
+		{
+			if (separations[i] > separations[face])
+				face = i;
+		}
+
+		mContactCount = 1;
+		mNormal = -B->Normals[face];
+		mContacts[0].position = mNormal * radius + circleCentre;
+		mContacts[0].feature = face;
+		mPenetration = radius;
+		return;
+	}
+
+	Vec2 toClosest = closest - centre;
+	float distSquared = toClosest.LenSqr();
+	if (distSquared > radius * radius)
+		return;
+
+	float distance = std::sqrt(distSquared);
+
+	mContactCount = 1;
+	mPenetration = radius - distance;
+
+	if (clampedX && clampedY) // Closest to a corner
+	{
+		int vertex = closest.x < 0.0f ? (closest.y < 0.0f ? 0 : 3) : (closest.y < 0.0f ? 1 : 2);
+
+		mNormal = toClosest / distance;
+		mContacts[0].position = closest + boxCentre;
+		mContacts[0].feature = POLYGON_VERTEX_FEATURE | vertex;
+	}
+	else // Closest to a face
+	{
+		int face = clampedX ? (centre.x > 0.0f ? 1 : 3) : (centre.y > 0.0f ? 2 : 0);
+
+		mNormal = -B->Normals[face];
+		mContacts[0].position = mNormal * radius + circleCentre;
+		mContacts[0].feature = face;
+	}
+}
+
+void Collision::AxisAlignedBoxToBoxCollision()
+{
+	BoxColliderComponent *A = static_cast<BoxColliderComponent *>(mColliderA);
+	BoxColliderComponent *B = static_cast<BoxColliderComponent *>(mColliderB);
+
+	mContactCount = 0;
+
+	Vec2 centreA = A->GetTransformComponent()->GetWorldPosition();
+	Vec2 centreB = B->GetTransformComponent()->GetWorldPosition();
+	Vec2 offset = centreB - centreA;
+
+	float overlapX = A->GetHalfWidth() + B->GetHalfWidth() - std::abs(offset.x);
+	if (overlapX <= 0.0f)
+		return;
+
+	float overlapY = A->GetHalfHeight() + B->GetHalfHeight() - std::abs(offset.y);
+	if (overlapY <= 0.0f)
+		return;
+
+	// Separate along the axis of least penetration. The overlap is the same from either box, and in that case the polygon routine
+	// takes its reference face from B. Matching it, including the contact order and features, means warm starting carries over
+	// if either box starts or stops rotating
+	int referenceFace;
+	if (overlapX < overlapY)
+	{
+		referenceFace = offset.x > 0.0f ? 3 : 1;
+		mPenetration = overlapX;
+	}
+	else
+	{
+		referenceFace = offset.y > 0.0f ? 0 : 2;
+		mPenetration = overlapY;
+	}
+
+	// Neither box is rotated, so model space only needs offsetting to get to world space
+	int incidentFace = (referenceFace + 2) % 4;
+	Vec2 v1 = B->Vertices[referenceFace] + centreB;
+	Vec2 v2 = B->Vertices[(referenceFace + 1) % 4] + centreB;
+	Vec2 face[2] = { A->Vertices[incidentFace] + centreA, A->Vertices[(incidentFace + 1) % 4] + centreA };
+
+	// Clip the incident face to the sides of the reference face. Both points are always behind the reference face
+	Vec2 sidePlaneNormal = B->Normals[(referenceFace + 1) % 4];
+	if (Clip(-sidePlaneNormal, -Dot(sidePlaneNormal, v1), face) < 2)
+		return;
+
+	if (Clip(sidePlaneNormal, Dot(sidePlaneNormal, v2), face) < 2)
+		return;
+
+	mNormal = -B->Normals[referenceFace];
+
+	// Identified by the incident face's second vertex as in FindIncidentFace
+	int feature = POLYGON_FLIP_FEATURE | (referenceFace << 16) | (((incidentFace + 1) % 4) << 8);
+	mContacts[0].position = face[0];
+	mContacts[0].feature = feature | 0;
+	mContacts[1].position = face[1];
+	mContacts[1].feature = feature | 1;
+	mContactCount = 2;
+}
+
 float Collision::GetFurthestPenetration(int * faceIndex, PolygonColliderComponent * A, PolygonColliderComponent * B)
 {
 	float bestDistance = -100000;
@@ -413,7 +633,7 @@ float Collision::GetFurthestPenetration(int * faceIndex, PolygonColliderComponen
 	return bestDistance;
 }
 
-void Collision::FindIncidentFace(Vec2 * v, PolygonColliderComponent * RefPoly, PolygonColliderComponent * IncPoly, int referenceIndex)
+int Collision::FindIncidentFace(Vec2 * v, PolygonColliderComponent * RefPoly, PolygonColliderComponent * IncPoly, int referenceIndex)
 {
 	Vec2 referenceNormal = RefPoly->Normals[referenceIndex];
 
@@ -438,6 +658,8 @@ void Collision::FindIncidentFace(Vec2 * v, PolygonColliderComponent * RefPoly, P
 	v[0] = IncPoly->GetRigidbodyComponent()->GetOrientationMatrix() * IncPoly->Vertices[incidentFace] + IncPoly->GetTransformComponent()->GetWorldPosition();
 	incidentFace = incidentFace + 1 >= (int)IncPoly->VertexCount ? 0 : incidentFace + 1;
 	v[1] = IncPoly->GetRigidbodyComponent()->GetOrientationMatrix() * IncPoly->Vertices[incidentFace] + IncPoly->GetTransformComponent()->GetWorldPosition();
+
+	return incidentFace;
 }
 
 int Collision::Clip(Vec2 n, float c, Vec2 * face)
@@ -3,6 +3,23 @@
 #include "ColliderComponent.h"
 #include "CircleColliderComponent.h"
 #include "PolygonColliderComponent.h"
+#include "BoxColliderComponent.h"
+
+struct ContactPoint
+{
+	Vec2			position;				 // World space point of contact
+	int				feature;				 // Identifies the features that generated this contact so it can be matched up next step
+
+	float			normalImpulse = 0;		 // Impulse accumulated along the normal over every solver iteration
+	float			tangentImpulse = 0;		 // Impulse accumulated along the tangent over every solver iteration
+
+	Vec2			radiiA;					 // From A's centre of mass to the contact
+	Vec2			radiiB;					 // From B's centre of mass to the contact
+	float			normalMass;				 // Inverse of the effective mass along the normal
+	float			tangentMass;			 // Inverse of the effective mass along the tangent
+	float			velocityBias;			 // Target separating velocity caused by restitution
+	float			friction;				 // Static friction if the contact is resting, dynamic friction if sliding
+};
 
 class Collision
 {
@@ -11,22 +28,37 @@ public:
 	~Collision();
 
 	int GetContactCount() { return mContactCount; }
+	bool HasSameContacts(const Collision& other) const; // Same colliders, normal, penetration and contact points, bit for bit
 
 	void CheckForCollision();				// Determine if there was a collision and generate contact information
+	void WarmStartFrom(const Collision& previous); // Copy accumulated impulses from last step's collision for the same pair
 	void PrepareToSolve(float deltaTime);   // Precalculations for impulse solving
-	void ResolveCollision();				// Resolve impulse and apply to rigidbody
+	void WarmStart();						// Apply last step's accumulated impulses
+	void ResolveCollision();				// Resolve impulse and apply to rigidbody. Called once per solver iteration
 	void PenetrationCorrection();			// Correction of positional penetration
 
 private:
+	typedef void (Collision::*CollisionFunction)();
+
+	// Routine for every pair of collider types, indexed by the types of A and B. A new collider type needs a new row and column
+	static const CollisionFunction DispatchTable[ColliderType::eColliderTypeCount][ColliderType::eColliderTypeCount];
+
 	void CircletoCircleCollision();
 	void CircleToPolygonCollision();
 	void PolygonToCircleCollision();
 	void PolygonToPolygonCollision();
 
+	// Boxes use the axis aligned routines when possible and fall back to the polygon routines when rotated
+	void CircleToBoxCollision();
+	void BoxToCircleCollision();
+	void BoxToBoxCollision();
+	void CircleToAxisAlignedBoxCollision();
+	void AxisAlignedBoxToBoxCollision();
+
 	void NullVelocities();
 
 	float GetFurthestPenetration(int* faceIndex, PolygonColliderComponent* A, PolygonColliderComponent *B);
-	void FindIncidentFace(Vec2 *v, PolygonColliderComponent *RefPoly, PolygonColliderComponent *IncPoly, int referenceIndex);
+	int FindIncidentFace(Vec2 *v, PolygonColliderComponent *RefPoly, PolygonColliderComponent *IncPoly, int referenceIndex);
 	int Clip(Vec2 n, float c, Vec2 *face);
 
 	ColliderComponent*		mColliderA;
@@ -34,10 +66,10 @@ private:
 
 	float					mPenetration;			 // Depth of penetration from collision
 	Vec2					mNormal;				 // From A to B
-	Vec2					mContacts[2];			 // Points of contact during collision
+	Vec2					mTangent;				 // Perpendicular to the normal. Fixed so tangent impulses stay comparable between steps
+	ContactPoint			mContacts[2];			 // Points of contact during collision
 	int						mContactCount;			 // Number of contacts that occured during collision
 	float					mMixedRestitution;       // Mixed restitution between the two colliders
 	float					mMixedDynamicFriction;   // Mixed dynamic friction between the two colliders
 	float					mMixedStaticFriction;	 // Mixed static friction between the two colliders
 };
-
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Consts.h"
+
+#include "GameObject.h"
+
+class ColliderComponent;
+
+// What a subscriber is told about a pair of colliders changing state. Always given from the subscriber's side of the pair
+struct CollisionEvent
+{
+	CollisionEventType			type;
+	ColliderComponent*			collider; // The subscriber's collider
+	ColliderComponent*			otherCollider;
+	EntityHandle				otherEntity;
+	GameObject*					otherObject; // Resolved from otherEntity. Only guaranteed to be valid during delivery
+};
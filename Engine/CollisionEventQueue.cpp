@@ -0,0 +1,137 @@
+#include "CollisionEventQueue.h"
+
+void CollisionEventQueue::Subscribe(ColliderComponent * collider, ICollisionListener * listener, const std::string & otherTag, int eventMask)
+{
+	if (collider == nullptr)
+		throw std::exception("Collision subscriptions need a collider to listen to.");
+
+	CollisionSubscription subscription;
+	subscription.listener = listener;
+	subscription.collider = collider;
+	subscription.tag = NO_TAG;
+	subscription.otherTag = TagTable::Instance().Intern(otherTag);
+	subscription.eventMask = eventMask;
+
+	AddSubscription(subscription);
+}
+
+void CollisionEventQueue::SubscribeToTag(const std::string & tag, ICollisionListener * listener, const std::string & otherTag, int eventMask)
+{
+	CollisionSubscription subscription;
+	subscription.listener = listener;
+	subscription.collider = nullptr;
+	subscription.tag = TagTable::Instance().Intern(tag);
+	subscription.otherTag = TagTable::Instance().Intern(otherTag);
+	subscription.eventMask = eventMask;
+
+	AddSubscription(subscription);
+}
+
+void CollisionEventQueue::Unsubscribe(ICollisionListener * listener)
+{
+	for (auto& subscription : mSubscriptions)
+	{
+		if (subscription.listener != listener)
+			continue;
+
+		if (subscription.eventMask & eCollisionPersist)
+			mPersistSubscriptionCount--;
+
+		// Only cleared here as the indices in mColliderSubscriptions may be in use
+		subscription.listener = nullptr;
+		mSubscriptionsChanged = true;
+	}
+}
+
+void CollisionEventQueue::Push(CollisionEventType type, int colliderA, int colliderB)
+{
+	QueuedEvent queuedEvent;
+	queuedEvent.type = type;
+	queuedEvent.colliderA = colliderA;
+	queuedEvent.colliderB = colliderB;
+
+	mEvents.push_back(queuedEvent);
+}
+
+void CollisionEventQueue::Deliver(const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities)
+{
+	if (mSubscriptionsChanged || mColliderSubscriptions.size() != colliders.size())
+		ResolveSubscriptions(colliders, entities);
+
+	mDeliveringEvents.swap(mEvents);
+	mEvents.clear();
+
+	for (auto& queuedEvent : mDeliveringEvents)
+	{
+		DeliverToSide(queuedEvent.type, queuedEvent.colliderA, queuedEvent.colliderB, colliders, entities);
+		DeliverToSide(queuedEvent.type, queuedEvent.colliderB, queuedEvent.colliderA, colliders, entities);
+	}
+
+	mDeliveringEvents.clear();
+}
+
+void CollisionEventQueue::AddSubscription(const CollisionSubscription & subscription)
+{
+	if (subscription.listener == nullptr)
+		throw std::exception("Collision subscriptions need a listener.");
+
+	if (subscription.eventMask & eCollisionPersist)
+		mPersistSubscriptionCount++;
+
+	mSubscriptions.push_back(subscription);
+	mSubscriptionsChanged = true;
+}
+
+void CollisionEventQueue::ResolveSubscriptions(const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities)
+{
+	mSubscriptions.erase(std::remove_if(mSubscriptions.begin(), mSubscriptions.end(),
+		[](const CollisionSubscription& subscription) { return subscription.listener == nullptr; }), mSubscriptions.end());
+
+	mColliderSubscriptions.resize(colliders.size());
+	for (int i = 0; i < colliders.size(); i++)
+	{
+		mColliderSubscriptions[i].clear();
+
+		GameObject* gameObject = EntityTable::Instance().Resolve(entities[i]);
+		if (gameObject == nullptr)
+			continue;
+
+		for (int j = 0; j < mSubscriptions.size(); j++)
+		{
+			const CollisionSubscription& subscription = mSubscriptions[j];
+			if (subscription.collider == colliders[i] || (subscription.collider == nullptr && subscription.tag == gameObject->GetTagID()))
+				mColliderSubscriptions[i].push_back(j);
+		}
+	}
+
+	mSubscriptionsChanged = false;
+}
+
+void CollisionEventQueue::DeliverToSide(CollisionEventType type, int self, int other, const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities)
+{
+	// Nothing to tell anyone about an object that has already been destroyed
+	GameObject* otherObject = EntityTable::Instance().Resolve(entities[other]);
+	if (otherObject == nullptr)
+		return;
+
+	for (int subscriptionIndex : mColliderSubscriptions[self])
+	{
+		const CollisionSubscription& subscription = mSubscriptions[subscriptionIndex];
+
+		if (subscription.listener == nullptr || !(subscription.eventMask & type))
+			continue;
+
+		if (subscription.otherTag != NO_TAG && subscription.otherTag != otherObject->GetTagID())
+			continue;
+
+		CollisionEvent collisionEvent;
+		collisionEvent.type = type;
+		collisionEvent.collider = colliders[self];
+		collisionEvent.otherCollider = colliders[other];
+		collisionEvent.otherEntity = entities[other];
+		collisionEvent.otherObject = otherObject;
+
+		// Last use of 'subscription'. The listener may subscribe something else, which can move it
+		subscription.listener->RecieveCollisionEvent(collisionEvent);
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "ICollisionListener.h"
+#include "ColliderComponent.h"
+
+struct CollisionSubscription
+{
+	ICollisionListener*		listener; // Set to null when unsubscribed. Removed the next time the subscriptions are resolved
+	ColliderComponent*		collider; // Null when subscribed by tag
+	TagID					tag; // Tag of the objects to listen to when subscribed by tag
+	TagID					otherTag; // Only events against objects with this tag are delivered. NO_TAG for every object
+	int						eventMask; // CollisionEventTypes to deliver
+};
+
+// Flat list of the collision events found during a physics step. Events are queued as the step runs and delivered together
+// at the end of it, so a pair that stays touching costs nothing unless something has asked to hear about it every step.
+class CollisionEventQueue
+{
+public:
+	// Tags are interned when subscribing so delivery only ever compares IDs
+	void Subscribe(ColliderComponent* collider, ICollisionListener* listener, const std::string& otherTag = "", int eventMask = eCollisionBegin | eCollisionEnd);
+	void SubscribeToTag(const std::string& tag, ICollisionListener* listener, const std::string& otherTag = "", int eventMask = eCollisionBegin | eCollisionEnd);
+	void Unsubscribe(ICollisionListener* listener); // Removes every subscription the listener has made. Safe to call while events are being delivered
+
+	bool WantsPersistEvents() const { return mPersistSubscriptionCount > 0; }
+
+	void Push(CollisionEventType type, int colliderA, int colliderB);
+	void Deliver(const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities); // Sends every queued event to its subscribers then empties the queue
+
+	int GetEventCount() const { return (int)mEvents.size(); }
+
+private:
+	struct QueuedEvent
+	{
+		CollisionEventType	type;
+		int					colliderA;
+		int					colliderB;
+	};
+
+	void AddSubscription(const CollisionSubscription& subscription);
+	void ResolveSubscriptions(const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities); // Works out which subscriptions apply to each collider so delivery doesn't have to search for them
+	void DeliverToSide(CollisionEventType type, int self, int other, const std::vector<ColliderComponent*>& colliders, const std::vector<EntityHandle>& entities);
+
+	std::vector<QueuedEvent>			mEvents;
+	std::vector<QueuedEvent>			mDeliveringEvents; // Events queued while delivering wait for the next step
+
+	std::vector<CollisionSubscription>	mSubscriptions;
+	std::vector<std::vector<int>>		mColliderSubscriptions; // Index into mSubscriptions of every subscription for each collider
+	bool								mSubscriptionsChanged = false;
+	int									mPersistSubscriptionCount = 0;
+};
@@ -0,0 +1,175 @@
+#include "CommandBuffer.h"
+#include "IScene.h"
+
+CommandBuffer::CommandBuffer()
+{
+}
+
+CommandBuffer::~CommandBuffer()
+{
+	for (auto entity : mGameObjects)
+	{
+		GameObject* gameObject = EntityTable::Instance().Resolve(entity);
+		if (gameObject != nullptr && gameObject->mCommandBuffer == this)
+			gameObject->mCommandBuffer = nullptr;
+	}
+
+	for (auto& command : mCommands)
+	{
+		if (command.type == eCommandAddComponent)
+			delete command.component;
+	}
+}
+
+void CommandBuffer::AddGameObject(GameObject * gameObject)
+{
+	if (gameObject->mCommandBuffer == this)
+		return;
+
+	if (gameObject->mCommandBuffer != nullptr)
+		throw std::exception("This object already records its changes in another scene.");
+
+	gameObject->mCommandBuffer = this;
+	mGameObjects.push_back(gameObject->GetHandle());
+}
+
+void CommandBuffer::Spawn(shared_ptr<GameObject> gameObject)
+{
+	StructuralCommand command = { eCommandSpawn, gameObject->GetHandle(), EntityHandle(), nullptr, (int)mSpawned.size(), false };
+	mCommands.push_back(command);
+	mSpawned.push_back(gameObject);
+}
+
+void CommandBuffer::Despawn(EntityHandle entity)
+{
+	mCommands.push_back({ eCommandDespawn, entity, EntityHandle(), nullptr, -1, false });
+}
+
+void CommandBuffer::SetActive(EntityHandle entity, bool active)
+{
+	mCommands.push_back({ eCommandSetActive, entity, EntityHandle(), nullptr, -1, active });
+}
+
+void CommandBuffer::SetParent(EntityHandle entity, EntityHandle parent)
+{
+	mCommands.push_back({ eCommandSetParent, entity, parent, nullptr, -1, false });
+}
+
+void CommandBuffer::AddComponent(EntityHandle entity, IComponent * component)
+{
+	if (component != nullptr)
+		mCommands.push_back({ eCommandAddComponent, entity, EntityHandle(), component, -1, false });
+}
+
+void CommandBuffer::RemoveComponent(EntityHandle entity, IComponent * component)
+{
+	if (component != nullptr)
+		mCommands.push_back({ eCommandRemoveComponent, entity, EntityHandle(), component, -1, false });
+}
+
+void CommandBuffer::Playback(IScene & scene)
+{
+	mPlaybackCommands.swap(mCommands);
+	mPlaybackSpawned.swap(mSpawned);
+	mLastPlaybackCount = 0;
+
+	// An object switched off and back on in the same frame only needs its final state applied, once
+	mLastSetActive.clear();
+	for (int i = 0; i < mPlaybackCommands.size(); i++)
+	{
+		if (mPlaybackCommands[i].type == eCommandSetActive)
+			mLastSetActive[mPlaybackCommands[i].entity.index] = i;
+	}
+
+	int i = 0;
+	try
+	{
+		for (; i < mPlaybackCommands.size(); i++)
+		{
+			StructuralCommand& command = mPlaybackCommands[i];
+			GameObject* gameObject = EntityTable::Instance().Resolve(command.entity);
+
+			if (gameObject == nullptr)
+			{
+				// Nothing else will ever own it
+				if (command.type == eCommandAddComponent)
+					delete command.component;
+
+				continue;
+			}
+
+			switch (command.type)
+			{
+			case eCommandSpawn:
+				scene.CacheComponents(mPlaybackSpawned[command.spawnIndex]);
+				break;
+
+			case eCommandDespawn:
+				DespawnRecursive(gameObject);
+				gameObject->SetParent(nullptr);
+				break;
+
+			case eCommandSetActive:
+				if (mLastSetActive[command.entity.index] != i)
+					continue;
+
+				if (gameObject->GetActive() != command.active)
+					gameObject->SetActive(command.active);
+				break;
+
+			case eCommandSetParent:
+			{
+				// A parent that has been destroyed since the command was recorded leaves the object where it is
+				GameObject* parent = EntityTable::Instance().Resolve(command.parent);
+				if (parent == nullptr && !command.parent.IsNull())
+					continue;
+
+				gameObject->SetParent(parent);
+				break;
+			}
+
+			case eCommandAddComponent:
+				command.component->SetActive(gameObject->GetActive());
+				gameObject->AddComponent(command.component);
+				scene.CacheComponent(gameObject, command.component);
+				break;
+
+			case eCommandRemoveComponent:
+				scene.UncacheComponent(gameObject, command.component);
+				gameObject->RemoveComponent(command.component);
+				break;
+			}
+
+			mLastPlaybackCount++;
+		}
+	}
+	catch (...)
+	{
+		// The rest of the commands are dropped, so the next playback doesn't start with this one's leftovers.
+		// Components they would have added have no other owner
+		for (int j = i + 1; j < mPlaybackCommands.size(); j++)
+		{
+			if (mPlaybackCommands[j].type == eCommandAddComponent)
+				delete mPlaybackCommands[j].component;
+		}
+
+		mPlaybackCommands.clear();
+		mPlaybackSpawned.clear();
+		throw;
+	}
+
+	mPlaybackCommands.clear();
+	mPlaybackSpawned.clear();
+}
+
+void CommandBuffer::DespawnRecursive(GameObject * gameObject)
+{
+	gameObject->SetActive(false);
+
+	for (auto child : gameObject->GetChildren())
+	{
+		GameObject* childObject = EntityTable::Instance().Resolve(child);
+		if (childObject != nullptr)
+			DespawnRecursive(childObject);
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "GameObject.h"
+
+class IScene;
+
+// Records structural changes to a scene - spawning, despawning, activating, reparenting and adding or removing
+// components - while the scene is being updated, and applies them all at the scene's sync point. Nothing that is
+// iterating the scene's objects or update lists ever sees them change underneath it.
+// Commands are only recorded from serial code: scene loading, serial updates and message or collision handlers.
+class CommandBuffer
+{
+public:
+	CommandBuffer();
+	~CommandBuffer(); // Detaches every object so none of them try to record commands on it afterwards
+
+	void AddGameObject(GameObject* gameObject); // Objects in the buffer record through it instead of changing straight away
+
+	void Spawn(shared_ptr<GameObject> gameObject); // Adds a newly built object to the scene
+	void Despawn(EntityHandle entity); // Deactivates the object and its children and detaches it from its parent
+	void SetActive(EntityHandle entity, bool active);
+	void SetParent(EntityHandle entity, EntityHandle parent); // A null parent unparents the object
+	void AddComponent(EntityHandle entity, IComponent* component); // Takes ownership of the component. It is deleted if the object is destroyed first
+	void RemoveComponent(EntityHandle entity, IComponent* component); // The component is deleted once it has been removed
+
+	void Playback(IScene& scene); // Sync point. Applies every command in the order it was recorded. Commands on destroyed objects are skipped. If a command throws, the rest are dropped and the exception passed on
+
+	int GetCommandCount() const { return (int)mCommands.size(); }
+	int GetLastPlaybackCount() const { return mLastPlaybackCount; } // Number of commands the last playback applied, after merging
+
+private:
+	enum CommandType
+	{
+		eCommandSpawn,
+		eCommandDespawn,
+		eCommandSetActive,
+		eCommandSetParent,
+		eCommandAddComponent,
+		eCommandRemoveComponent
+	};
+
+	struct StructuralCommand
+	{
+		CommandType		type;
+		EntityHandle	entity;
+		EntityHandle	parent;
+		IComponent*		component;
+		int				spawnIndex; // Index into mSpawned
+		bool			active;
+	};
+
+	void DespawnRecursive(GameObject* gameObject);
+
+	vector<StructuralCommand>				mCommands;
+	vector<shared_ptr<GameObject>>			mSpawned; // Kept alive until the scene takes them at playback
+
+	// Swapped with the recording buffers at playback, so anything recorded while playing back waits for the next sync point
+	vector<StructuralCommand>				mPlaybackCommands;
+	vector<shared_ptr<GameObject>>			mPlaybackSpawned;
+
+	unordered_map<uint32_t, int>			mLastSetActive; // Last activation command for each entity index. Earlier ones are skipped
+
+	vector<EntityHandle>					mGameObjects;
+	int										mLastPlaybackCount = 0;
+};
@@ -0,0 +1,114 @@
+#include "ComponentBenchmark.h"
+
+#include <chrono>
+
+namespace
+{
+	// Stand ins for real components. Half of them update, like a typical game object
+	template<int N>
+	class BenchmarkComponent : public IComponent
+	{
+	public:
+		BenchmarkComponent() { mType = "BenchmarkComponent"; }
+	};
+
+	template<int N>
+	class BenchmarkUpdateableComponent : public IComponent, public IUpdateable
+	{
+	public:
+		BenchmarkUpdateableComponent() { mType = "BenchmarkUpdateableComponent"; }
+		void Update(float deltaTime) override { mElapsed += deltaTime; }
+
+		float				mElapsed = 0;
+	};
+
+	typedef BenchmarkComponent<0>				FirstComponent;
+	typedef BenchmarkComponent<5>				LastComponent;
+
+	// How GameObject found components before they were looked up by type ID
+	template<class T>
+	T * FindByCast(const vector<IComponent*>& components)
+	{
+		for (auto component : components)
+		{
+			T* tComponent = dynamic_cast<T *> (component);
+			if (tComponent != nullptr)
+				return tComponent;
+		}
+
+		return nullptr;
+	}
+
+	void UpdateByCast(const vector<IComponent*>& components, float deltaTime)
+	{
+		for (auto component : components)
+		{
+			if (component->GetActive())
+			{
+				IUpdateable* updateableComponent = dynamic_cast<IUpdateable *> (component);
+				if (updateableComponent != nullptr)
+					updateableComponent->Update(deltaTime);
+			}
+		}
+	}
+
+	// Runs 'func' over every object 'iterations' times. Returns the average per object
+	template<class Func>
+	float TimePerObject(int objectCount, int iterations, Func func)
+	{
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			for (int j = 0; j < objectCount; j++)
+				func(j);
+		}
+
+		return chrono::duration<float, nano>(chrono::steady_clock::now() - start).count() / ((float)objectCount * iterations);
+	}
+}
+
+ComponentLookupBenchmark ComponentBenchmark::Run(int objectCount, int iterations)
+{
+	vector<shared_ptr<GameObject>> objects;
+	vector<vector<IComponent*>> components; // What the old lookups walked, copied out once so the copy isn't timed
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		auto gameObject = GameObject::MakeGameObject("Benchmark", i);
+		gameObject->AddComponent(new FirstComponent());
+		gameObject->AddComponent(new BenchmarkUpdateableComponent<1>());
+		gameObject->AddComponent(new BenchmarkComponent<2>());
+		gameObject->AddComponent(new BenchmarkUpdateableComponent<3>());
+		gameObject->AddComponent(new BenchmarkUpdateableComponent<4>());
+		gameObject->AddComponent(new LastComponent());
+
+		objects.push_back(gameObject);
+		components.push_back(gameObject->GetAllComponents());
+	}
+
+	ComponentLookupBenchmark benchmark;
+	benchmark.objectCount = objectCount;
+	benchmark.componentsPerObject = (int)components[0].size();
+	benchmark.iterations = iterations;
+
+	// Every lookup adds to this so none of them can be optimised away
+	volatile uintptr_t found = 0;
+
+	// Each type is looked up once before timing, so the masks are cached as they would be after the first frame
+	for (auto& gameObject : objects)
+		found = found + (uintptr_t)gameObject->GetComponent<FirstComponent>() + (uintptr_t)gameObject->GetComponent<LastComponent>() + (uintptr_t)gameObject->GetComponent<IUpdateable>();
+
+	benchmark.firstComponent.typeIDNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)objects[i]->GetComponent<FirstComponent>(); });
+	benchmark.firstComponent.dynamicCastNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)FindByCast<FirstComponent>(components[i]); });
+
+	benchmark.lastComponent.typeIDNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)objects[i]->GetComponent<LastComponent>(); });
+	benchmark.lastComponent.dynamicCastNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)FindByCast<LastComponent>(components[i]); });
+
+	benchmark.interfaceComponent.typeIDNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)objects[i]->GetComponent<IUpdateable>(); });
+	benchmark.interfaceComponent.dynamicCastNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { found = found + (uintptr_t)FindByCast<IUpdateable>(components[i]); });
+
+	benchmark.update.typeIDNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { objects[i]->Update(0.016f); });
+	benchmark.update.dynamicCastNanoseconds = TimePerObject(objectCount, iterations, [&](int i) { UpdateByCast(components[i], 0.016f); });
+
+	return benchmark;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "GameObject.h"
+
+struct ComponentLookupTiming
+{
+	float		typeIDNanoseconds = 0; // Average per object, through the cached type ID masks
+	float		dynamicCastNanoseconds = 0; // Average per object, casting every component in turn as GameObject used to
+};
+
+struct ComponentLookupBenchmark
+{
+	int						objectCount = 0;
+	int						componentsPerObject = 0;
+	int						iterations = 0;
+	ComponentLookupTiming	firstComponent; // GetComponent of the first component added
+	ComponentLookupTiming	lastComponent;
+	ComponentLookupTiming	interfaceComponent; // GetComponent<IUpdateable>, which needs a cross cast either way
+	ComponentLookupTiming	update; // GameObject::Update
+};
+
+// Times looking components up by type ID against the dynamic_cast lookups GameObject used before, on objects built only
+// for the benchmark. Run the game with -benchmarkcomponents
+namespace ComponentBenchmark
+{
+	ComponentLookupBenchmark Run(int objectCount, int iterations);
+}
@@ -0,0 +1,97 @@
+#include "ComponentParserRegistry.h"
+
+#include "ComponentParsers.h"
+#include "ObjectManager.h"
+
+GameObject * ComponentParseContext::FindObject(int instanceID) const
+{
+	if (instanceID == -1)
+		return gameObject.get();
+
+	if (objects == nullptr)
+		throw std::exception("Components built from a prefab outside of a scene can only refer to their own object.");
+
+	GameObject* object = objects->GetCreatedObject(instanceID).get();
+	if (object == nullptr)
+		throw std::exception(("The scene refers to the object " + to_string(instanceID) + " before it is built.").c_str());
+
+	return object;
+}
+
+CompiledComponent CompiledComponent::Override(const SceneNode & node) const
+{
+	return CompiledComponent(mComponentType, mArgs->Override(node), mInactive || node.HasAttribute("componentinactive"));
+}
+
+CompiledComponent CompiledComponent::Override(const char * attribute, const string & value) const
+{
+	return CompiledComponent(mComponentType, mArgs->Override(SceneAttribute{ HashSceneName(attribute), attribute, value.c_str(), nullptr }), mInactive);
+}
+
+IComponent * CompiledComponent::Build(const ComponentParseContext & context) const
+{
+	IComponent* component = mArgs->Build(context);
+
+	if (mInactive)
+		component->SetActive(false);
+
+	return component;
+}
+
+ComponentParserRegistry::ComponentParserRegistry()
+{
+	ComponentParsers::RegisterEngineParsers(*this);
+}
+
+void ComponentParserRegistry::Register(const char * componentType, ComponentParser parser)
+{
+	uint32_t hash = HashSceneName(componentType);
+
+	auto existing = mParsers.find(hash);
+	if (existing != mParsers.end())
+		throw std::exception(("Can't register the component type " + string(componentType) + ". " + existing->second.componentType + " is already registered with the same hash.").c_str());
+
+	Entry entry;
+	entry.componentType = componentType;
+	entry.parser = parser;
+	mParsers.insert(make_pair(hash, entry));
+}
+
+bool ComponentParserRegistry::IsRegistered(const char * componentType) const
+{
+	return Find(componentType) != nullptr;
+}
+
+IComponent * ComponentParserRegistry::Parse(const ComponentParseContext & context) const
+{
+	const char* componentType = context.node.GetValue("type");
+
+	const Entry* entry = Find(componentType);
+	if (entry == nullptr)
+		throw std::exception(("ATTEMPTING TO CREATE A COMPONENT OF AN UNRECOGNISED TYPE: " + string(componentType)).c_str());
+
+	return entry->parser(context);
+}
+
+CompiledComponent ComponentParserRegistry::Compile(const SceneNode & node) const
+{
+	const char* componentType = node.GetValue("type");
+
+	const Entry* entry = Find(componentType);
+	if (entry == nullptr)
+		throw std::exception(("ATTEMPTING TO CREATE A COMPONENT OF AN UNRECOGNISED TYPE: " + string(componentType)).c_str());
+
+	if (!entry->compile)
+		throw std::exception(("The component type " + string(componentType) + " can't be compiled, so can't be part of a prefab.").c_str());
+
+	return CompiledComponent(entry->componentType, entry->compile(node), node.HasAttribute("componentinactive"));
+}
+
+const ComponentParserRegistry::Entry * ComponentParserRegistry::Find(const char * componentType) const
+{
+	auto it = mParsers.find(HashSceneName(componentType));
+	if (it == mParsers.end() || it->second.componentType != componentType)
+		return nullptr;
+
+	return &it->second;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameObject.h"
+#include "ICameraGameObject.h"
+#include "SceneNode.h"
+
+using namespace std;
+
+class ObjectManager;
+
+// Everything a parser gets to build a component from its scene node
+struct ComponentParseContext
+{
+	ComponentParseContext(ObjectManager* objects, shared_ptr<GameObject> gameObject, const SceneNode& node, ICameraGameObject* camera)
+		: objects(objects), gameObject(gameObject), node(node), camera(camera) { }
+
+	GameObject* FindObject(int instanceID) const; // An object the scene has already built, or the one being built if the id is -1. Throws if there isn't one
+
+	template<class T>
+	T* FindComponent(int instanceID) const { return FindObject(instanceID)->GetComponent<T>(); }
+
+	ObjectManager*					objects; // Null when building from a prefab outside of a scene build, in which case components can only refer to their own object
+	shared_ptr<GameObject>			gameObject; // The object the component is being added to
+	SceneNode						node; // Null when building from compiled arguments
+	ICameraGameObject*				camera;
+};
+
+enum ComponentAttributeUse
+{
+	eAttributeRequired,
+	eAttributeOptional // Keeps the value the arguments struct was constructed with when missing
+};
+
+// Binds one attribute name to a member of a parser's arguments struct
+template<class Args>
+struct ComponentAttribute
+{
+	ComponentAttribute(const char* name, int Args::* member, ComponentAttributeUse use = eAttributeRequired) : name(name), use(use), intMember(member) { }
+	ComponentAttribute(const char* name, float Args::* member, ComponentAttributeUse use = eAttributeRequired) : name(name), use(use), floatMember(member) { }
+	ComponentAttribute(const char* name, bool Args::* member, ComponentAttributeUse use = eAttributeRequired) : name(name), use(use), boolMember(member) { }
+	ComponentAttribute(const char* name, string Args::* member, ComponentAttributeUse use = eAttributeRequired) : name(name), use(use), stringMember(member) { }
+
+	void Read(const SceneAttribute& attribute, Args& args) const
+	{
+		if (intMember != nullptr)
+			args.*intMember = attribute.GetInt();
+		else if (floatMember != nullptr)
+			args.*floatMember = attribute.GetFloat();
+		else if (boolMember != nullptr)
+			args.*boolMember = attribute.GetBool();
+		else
+			args.*stringMember = attribute.value;
+	}
+
+	const char*						name;
+	ComponentAttributeUse			use;
+	int Args::*						intMember = nullptr; // Only the one matching the attribute's type is set
+	float Args::*					floatMember = nullptr;
+	bool Args::*					boolMember = nullptr;
+	string Args::*					stringMember = nullptr;
+};
+
+// The attributes a component type reads, resolved up front so a node's attributes are only walked once.
+// Attributes the schema doesn't know about, like "type", are skipped
+template<class Args>
+class ComponentSchema
+{
+public:
+	ComponentSchema(const char* componentType, initializer_list<ComponentAttribute<Args>> attributes) : mComponentType(componentType), mAttributes(attributes)
+	{
+		if (mAttributes.size() > 64)
+			throw std::exception(("Too many attributes in the schema for " + mComponentType + ".").c_str());
+
+		for (size_t i = 0; i < mAttributes.size(); i++)
+		{
+			mHashes.push_back(HashSceneName(mAttributes[i].name));
+			if (mAttributes[i].use == eAttributeRequired)
+				mRequiredMask |= 1ull << i;
+		}
+	}
+
+	void Read(const SceneNode& node, Args& args, bool checkRequired = true) const // Overrides of already read arguments don't need every attribute
+	{
+		uint64_t foundMask = 0;
+		node.ForEachAttribute([&](const SceneAttribute& attribute)
+		{
+			int index = ReadAttribute(attribute, args);
+			if (index != -1)
+				foundMask |= 1ull << index;
+		});
+
+		if (!checkRequired || (foundMask & mRequiredMask) == mRequiredMask)
+			return;
+
+		for (size_t i = 0; i < mAttributes.size(); i++)
+		{
+			if ((mRequiredMask & ~foundMask) & (1ull << i))
+				throw std::exception(("The scene is missing the attribute " + string(mAttributes[i].name) + " of a " + mComponentType + ".").c_str());
+		}
+	}
+
+	int ReadAttribute(const SceneAttribute& attribute, Args& args) const // Returns the attribute's index in the schema, or -1 if the schema doesn't have it
+	{
+		for (size_t i = 0; i < mHashes.size(); i++)
+		{
+			if (mHashes[i] == attribute.nameHash && strcmp(mAttributes[i].name, attribute.name) == 0)
+			{
+				mAttributes[i].Read(attribute, args);
+				return (int)i;
+			}
+		}
+
+		return -1;
+	}
+
+private:
+	string								mComponentType;
+	vector<ComponentAttribute<Args>>	mAttributes;
+	vector<uint32_t>					mHashes; // Kept apart from the attributes so the scan only touches the hashes
+	uint64_t							mRequiredMask = 0;
+};
+
+typedef function<IComponent*(const ComponentParseContext&)> ComponentParser;
+
+// Schema, child reader and build step of a parser registered with an arguments struct
+template<class Args>
+struct TypedComponentParser
+{
+	TypedComponentParser(const char* componentType, initializer_list<ComponentAttribute<Args>> attributes) : schema(componentType, attributes) { }
+
+	void Read(const SceneNode& node, Args& args, bool checkRequired) const
+	{
+		schema.Read(node, args, checkRequired);
+		if (readChildren)
+			readChildren(node, args);
+	}
+
+	ComponentSchema<Args>												schema;
+	function<void(const SceneNode&, Args&)>								readChildren; // Optional. For types that read child nodes as well as attributes
+	function<IComponent*(const ComponentParseContext&, const Args&)>	build;
+};
+
+// Arguments of a component that have already been read, so the component can be built any number of times without its scene node
+class IComponentArgs
+{
+public:
+	virtual ~IComponentArgs() { }
+
+	virtual shared_ptr<IComponentArgs> Override(const SceneNode& node) const = 0; // Copy with the node's attributes read over it
+	virtual shared_ptr<IComponentArgs> Override(const SceneAttribute& attribute) const = 0; // Throws if the schema has no such attribute
+	virtual IComponent* Build(const ComponentParseContext& context) const = 0;
+};
+
+template<class Args>
+class ComponentArgs : public IComponentArgs
+{
+public:
+	ComponentArgs(shared_ptr<const TypedComponentParser<Args>> parser, const Args& args) : mParser(parser), mArgs(args) { }
+
+	shared_ptr<IComponentArgs> Override(const SceneNode& node) const override
+	{
+		auto copy = make_shared<ComponentArgs<Args>>(mParser, mArgs);
+		mParser->Read(node, copy->mArgs, false);
+		return copy;
+	}
+
+	shared_ptr<IComponentArgs> Override(const SceneAttribute& attribute) const override
+	{
+		auto copy = make_shared<ComponentArgs<Args>>(mParser, mArgs);
+		if (mParser->schema.ReadAttribute(attribute, copy->mArgs) == -1)
+			throw std::exception(("The component has no attribute " + string(attribute.name) + ".").c_str());
+
+		return copy;
+	}
+
+	IComponent* Build(const ComponentParseContext& context) const override { return mParser->build(context, mArgs); }
+
+private:
+	shared_ptr<const TypedComponentParser<Args>>	mParser;
+	Args											mArgs;
+};
+
+// A Component node compiled once into its arguments. Building from it skips reading the node altogether, which is what
+// prefabs are made of
+class CompiledComponent
+{
+public:
+	CompiledComponent(const string& componentType, shared_ptr<const IComponentArgs> args, bool inactive)
+		: mComponentType(componentType), mArgs(args), mInactive(inactive) { }
+
+	const string& GetType() const { return mComponentType; }
+
+	CompiledComponent Override(const SceneNode& node) const; // Attributes the node has replace the compiled ones
+	CompiledComponent Override(const char* attribute, const string& value) const;
+
+	IComponent* Build(const ComponentParseContext& context) const; // Starts inactive if the node it was compiled from did
+
+private:
+	string								mComponentType;
+	shared_ptr<const IComponentArgs>	mArgs;
+	bool								mInactive;
+};
+
+// Maps the "type" attribute of a Component node to the parser that builds it, by the hash of the type name.
+// The engine registers its own components when the registry is first used. Game code registers the rest through Register
+class ComponentParserRegistry
+{
+public:
+	static ComponentParserRegistry& Instance()
+	{
+		static ComponentParserRegistry instance;
+		return instance;
+	}
+
+	void Register(const char* componentType, ComponentParser parser); // Throws if the type, or another type with the same hash, is already registered
+
+	// Registers a parser that gets its attributes read into an Args, through the schema, before it is called. Only these can be compiled
+	template<class Args>
+	void Register(const char* componentType, initializer_list<ComponentAttribute<Args>> attributes, function<IComponent*(const ComponentParseContext&, const Args&)> build,
+		function<void(const SceneNode&, Args&)> readChildren = nullptr)
+	{
+		auto typed = make_shared<TypedComponentParser<Args>>(componentType, attributes);
+		typed->readChildren = readChildren;
+		typed->build = build;
+
+		Register(componentType, [typed](const ComponentParseContext& context)
+		{
+			Args args;
+			typed->Read(context.node, args, true);
+			return typed->build(context, args);
+		});
+
+		mParsers[HashSceneName(componentType)].compile = [typed](const SceneNode& node)
+		{
+			Args args;
+			typed->Read(node, args, true);
+			return shared_ptr<IComponentArgs>(make_shared<ComponentArgs<Args>>(typed, args));
+		};
+	}
+
+	bool IsRegistered(const char* componentType) const;
+	IComponent* Parse(const ComponentParseContext& context) const; // Throws if the node's type isn't registered
+	CompiledComponent Compile(const SceneNode& node) const; // Throws if the node's type isn't registered or wasn't registered with an arguments struct
+
+private:
+	ComponentParserRegistry();
+
+	struct Entry
+	{
+		string													componentType; // Checked on lookup so a type that merely shares a hash is never parsed as another
+		ComponentParser											parser;
+		function<shared_ptr<IComponentArgs>(const SceneNode&)>	compile;
+	};
+
+	const Entry* Find(const char* componentType) const;
+
+	unordered_map<uint32_t, Entry>		mParsers;
+};
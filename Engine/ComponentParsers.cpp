@@ -0,0 +1,330 @@
+#include "ComponentParsers.h"
+
+#include "ComponentFactory.h"
+
+namespace
+{
+	struct TransformArgs
+	{
+		float xpos = 0, ypos = 0, rotation = 0, scale = 0;
+	};
+
+	struct SpriteRendererArgs
+	{
+		string fileName;
+		int transformComponentID = -1;
+		float width = 0, height = 0, xOffset = 0, yOffset = 0;
+		int renderLayer = 0;
+	};
+
+	struct SpriteAnimatorArgs
+	{
+		string fileName;
+		int transformComponentID = -1;
+		float width = 0, height = 0;
+		int currentAnim = 0;
+		int renderLayer = 0;
+		vector<AnimationDesc> animations; // From the AnimDesc child nodes
+	};
+
+	struct AnimationDescArgs
+	{
+		int startingIndex = 0, endingIndex = 0, x = 0, y = 0, width = 0, height = 0, frameCount = 0;
+		float holdTime = 0;
+	};
+
+	struct RigidBodyArgs
+	{
+		float staticFriction = 0, dynamicFriction = 0, restitution = 0;
+		bool isStatic = false, lockRotation = false;
+		bool continuous = false;
+	};
+
+	struct TextRendererArgs
+	{
+		string text;
+		int transformComponentID = -1;
+	};
+
+	struct CircleColliderArgs
+	{
+		float radius = 0;
+		int transformComponentID = -1, rigidBodyComponentID = -1;
+		string layer;
+	};
+
+	struct BoxColliderArgs
+	{
+		float width = 0, height = 0;
+		int transformComponentID = -1, rigidBodyComponentID = -1;
+		string layer;
+	};
+
+	struct TiledBGArgs
+	{
+		string spriteName;
+		float width = 0, height = 0, moveRate = 0;
+		string direction;
+		int transformComponentID = -1, focusTransformComponentID = -1;
+		int renderLayer = 0;
+	};
+
+	struct TriggerBoxArgs
+	{
+		string triggerTag;
+	};
+
+	struct GUITextArgs
+	{
+		string text;
+		int transformComponentID = -1;
+		float r = 0, g = 0, b = 0, xOffset = 0, yOffset = 0;
+		int renderLayer = 0;
+	};
+
+	struct GUIButtonArgs
+	{
+		int transformComponentID = -1;
+		float width = 0, height = 0;
+	};
+
+	struct GUISpriteRendererArgs
+	{
+		string fileName;
+		int transformComponentID = -1;
+		float width = 0, height = 0, xOffset = 0, yOffset = 0;
+		int renderLayer = 0;
+	};
+
+	// Animation descriptions are child nodes of the animator, so have their own schema
+	const ComponentSchema<AnimationDescArgs>& AnimationDescSchema()
+	{
+		static ComponentSchema<AnimationDescArgs> schema("AnimDesc", {
+			{ "startingindex", &AnimationDescArgs::startingIndex },
+			{ "endingindex", &AnimationDescArgs::endingIndex },
+			{ "x", &AnimationDescArgs::x },
+			{ "y", &AnimationDescArgs::y },
+			{ "width", &AnimationDescArgs::width },
+			{ "height", &AnimationDescArgs::height },
+			{ "framecount", &AnimationDescArgs::frameCount },
+			{ "holdtime", &AnimationDescArgs::holdTime } });
+
+		return schema;
+	}
+}
+
+void ComponentParsers::RegisterEngineParsers(ComponentParserRegistry & registry)
+{
+	registry.Register<TransformArgs>("TransformComponent", {
+		{ "xpos", &TransformArgs::xpos },
+		{ "ypos", &TransformArgs::ypos },
+		{ "rotation", &TransformArgs::rotation },
+		{ "scale", &TransformArgs::scale } },
+		[](const ComponentParseContext& context, const TransformArgs& args)
+	{
+		return ComponentFactory::MakeTransform(Vec2(args.xpos, -args.ypos), args.rotation, args.scale);
+	});
+
+	registry.Register<SpriteRendererArgs>("SpriteRendererComponent", {
+		{ "filename", &SpriteRendererArgs::fileName },
+		{ "transformcomponentid", &SpriteRendererArgs::transformComponentID },
+		{ "width", &SpriteRendererArgs::width },
+		{ "height", &SpriteRendererArgs::height },
+		{ "xoffset", &SpriteRendererArgs::xOffset },
+		{ "yoffset", &SpriteRendererArgs::yOffset },
+		{ "renderLayer", &SpriteRendererArgs::renderLayer } },
+		[](const ComponentParseContext& context, const SpriteRendererArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeSpriteRenderer(args.fileName, args.renderLayer, trans, args.width, args.height, Vec2(args.xOffset, args.yOffset));
+	});
+
+	registry.Register<SpriteAnimatorArgs>("SpriteAnimatorComponent", {
+		{ "filename", &SpriteAnimatorArgs::fileName },
+		{ "transformcomponentid", &SpriteAnimatorArgs::transformComponentID },
+		{ "width", &SpriteAnimatorArgs::width },
+		{ "height", &SpriteAnimatorArgs::height },
+		{ "currentAnim", &SpriteAnimatorArgs::currentAnim },
+		{ "renderLayer", &SpriteAnimatorArgs::renderLayer } },
+		[](const ComponentParseContext& context, const SpriteAnimatorArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeSpriteAnimator(args.fileName, args.renderLayer, trans, args.width, args.height, args.animations, args.currentAnim);
+	},
+		[](const SceneNode& node, SpriteAnimatorArgs& args)
+	{
+		// Overrides without any animations keep the ones they are overriding
+		SceneNode animDescs = node.FirstChild("AnimDesc");
+		if (animDescs)
+			args.animations.clear();
+
+		while (animDescs)
+		{
+			AnimationDescArgs desc;
+			AnimationDescSchema().Read(animDescs, desc);
+			args.animations.push_back(AnimationDesc(desc.startingIndex, desc.endingIndex, desc.x, desc.y, desc.width, desc.height, desc.frameCount, desc.holdTime));
+
+			animDescs = animDescs.NextSibling("AnimDesc");
+		}
+	});
+
+	registry.Register<RigidBodyArgs>("RigidBodyComponent", {
+		{ "staticfriction", &RigidBodyArgs::staticFriction },
+		{ "dynamicfriction", &RigidBodyArgs::dynamicFriction },
+		{ "restitution", &RigidBodyArgs::restitution },
+		{ "static", &RigidBodyArgs::isStatic },
+		{ "lockrotation", &RigidBodyArgs::lockRotation },
+		{ "continuous", &RigidBodyArgs::continuous, eAttributeOptional } },
+		[](const ComponentParseContext& context, const RigidBodyArgs& args)
+	{
+		RigidBodyComponent* rb = ComponentFactory::MakeRigidbody(args.staticFriction, args.dynamicFriction, args.restitution, args.isStatic, args.lockRotation);
+		rb->SetContinuous(args.continuous); // For bodies fast enough to pass through thin colliders in a single step
+		return rb;
+	});
+
+	registry.Register<TextRendererArgs>("TextRendererComponent", {
+		{ "text", &TextRendererArgs::text },
+		{ "transformcomponentid", &TextRendererArgs::transformComponentID } },
+		[](const ComponentParseContext& context, const TextRendererArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeTextRenderer(args.text, DirectX::Colors::Yellow, trans); // TODO: Remove default yellow colour
+	});
+
+	registry.Register<CircleColliderArgs>("CircleColliderComponent", {
+		{ "radius", &CircleColliderArgs::radius },
+		{ "transformcomponentid", &CircleColliderArgs::transformComponentID },
+		{ "rigidbodycomponentid", &CircleColliderArgs::rigidBodyComponentID },
+		{ "layer", &CircleColliderArgs::layer, eAttributeOptional } },
+		[](const ComponentParseContext& context, const CircleColliderArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		RigidBodyComponent* rb = context.FindComponent<RigidBodyComponent>(args.rigidBodyComponentID);
+
+		CircleColliderComponent* collider = ComponentFactory::MakeCircleCollider(args.radius, trans, rb);
+		collider->SetLayerMask(ParseLayerMask(args.layer));
+		return collider;
+	});
+
+	registry.Register("PolygonColliderComponent", [](const ComponentParseContext& context) -> IComponent*
+	{
+		throw exception("NOT IMPLEMENTED YOU FOOL");
+	});
+
+	registry.Register<BoxColliderArgs>("BoxColliderComponent", {
+		{ "width", &BoxColliderArgs::width },
+		{ "height", &BoxColliderArgs::height },
+		{ "transformcomponentid", &BoxColliderArgs::transformComponentID },
+		{ "rigidbodycomponentid", &BoxColliderArgs::rigidBodyComponentID },
+		{ "layer", &BoxColliderArgs::layer, eAttributeOptional } },
+		[](const ComponentParseContext& context, const BoxColliderArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		RigidBodyComponent* rb = context.FindComponent<RigidBodyComponent>(args.rigidBodyComponentID);
+
+		BoxColliderComponent* collider = ComponentFactory::MakeBoxCollider(args.width, args.height, trans, rb);
+		collider->SetLayerMask(ParseLayerMask(args.layer));
+		return collider;
+	});
+
+	registry.Register("ColliderRendererComponent", [](const ComponentParseContext& context) -> IComponent*
+	{
+		throw exception("NOT IMPLEMENTED YOU FOOL");
+	});
+
+	registry.Register<TiledBGArgs>("TiledBGRenderer", {
+		{ "spritename", &TiledBGArgs::spriteName },
+		{ "spritewidth", &TiledBGArgs::width },
+		{ "spriteheight", &TiledBGArgs::height },
+		{ "moverate", &TiledBGArgs::moveRate },
+		{ "direction", &TiledBGArgs::direction },
+		{ "transformcomponentid", &TiledBGArgs::transformComponentID },
+		{ "focustransformcomponentid", &TiledBGArgs::focusTransformComponentID },
+		{ "renderLayer", &TiledBGArgs::renderLayer } },
+		[](const ComponentParseContext& context, const TiledBGArgs& args)
+	{
+		TiledBGDirection dir;
+		if (args.direction == "horizontal")
+			dir = TiledBGDirection::eHorizontal;
+		else if (args.direction == "vertical")
+			dir = TiledBGDirection::eVertical;
+		else
+			dir = TiledBGDirection::eHoriztonalAndVertical;
+
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		TransformComponent* focusTrans = context.FindComponent<TransformComponent>(args.focusTransformComponentID);
+
+		return ComponentFactory::MakeTiledBGRenderer(args.spriteName, args.renderLayer, args.width, args.height, args.moveRate, dir, trans, focusTrans);
+	});
+
+	registry.Register<TriggerBoxArgs>("TriggerBoxComponent", {
+		{ "triggertag", &TriggerBoxArgs::triggerTag } },
+		[](const ComponentParseContext& context, const TriggerBoxArgs& args)
+	{
+		return ComponentFactory::MakeTriggerBox(args.triggerTag);
+	});
+
+	registry.Register<GUITextArgs>("GUITextComponent", {
+		{ "text", &GUITextArgs::text },
+		{ "transformcomponentid", &GUITextArgs::transformComponentID },
+		{ "r", &GUITextArgs::r },
+		{ "g", &GUITextArgs::g },
+		{ "b", &GUITextArgs::b },
+		{ "xoffset", &GUITextArgs::xOffset },
+		{ "yoffset", &GUITextArgs::yOffset },
+		{ "renderLayer", &GUITextArgs::renderLayer } },
+		[](const ComponentParseContext& context, const GUITextArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeGUIText(args.text, args.renderLayer, args.r, args.g, args.b, trans, Vec2(args.xOffset, args.yOffset));
+	});
+
+	registry.Register<GUIButtonArgs>("GUIButtonComponent", {
+		{ "transformcomponentid", &GUIButtonArgs::transformComponentID },
+		{ "width", &GUIButtonArgs::width },
+		{ "height", &GUIButtonArgs::height } },
+		[](const ComponentParseContext& context, const GUIButtonArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeGUIButton(trans, args.width, args.height);
+	});
+
+	registry.Register<GUISpriteRendererArgs>("GUISpriteRendererComponent", {
+		{ "filename", &GUISpriteRendererArgs::fileName },
+		{ "transformcomponentid", &GUISpriteRendererArgs::transformComponentID },
+		{ "width", &GUISpriteRendererArgs::width },
+		{ "height", &GUISpriteRendererArgs::height },
+		{ "xoffset", &GUISpriteRendererArgs::xOffset },
+		{ "yoffset", &GUISpriteRendererArgs::yOffset },
+		{ "renderLayer", &GUISpriteRendererArgs::renderLayer } },
+		[](const ComponentParseContext& context, const GUISpriteRendererArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeGUISpriteRenderer(args.fileName, args.renderLayer, trans, args.width, args.height, Vec2(args.xOffset, args.yOffset));
+	});
+}
+
+unsigned int ComponentParsers::ParseLayerMask(const string & layers)
+{
+	if (layers.empty())
+		return 1 << eLayerDefault;
+
+	unsigned int layerMask = 0;
+
+	size_t start = 0;
+	while (start <= layers.size())
+	{
+		size_t end = layers.find(',', start);
+		if (end == string::npos)
+			end = layers.size();
+
+		auto layer = CollisionLayerNames.find(layers.substr(start, end - start));
+		if (layer == CollisionLayerNames.end())
+			throw std::exception("Unknown collision layer.");
+
+		layerMask |= 1 << layer->second;
+		start = end + 1;
+	}
+
+	return layerMask;
+}
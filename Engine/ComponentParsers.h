@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ComponentParserRegistry.h"
+
+// Parsers for the component types a scene can describe. Each type lists the attributes it reads and builds
+// its component through ComponentFactory
+namespace ComponentParsers
+{
+	void RegisterEngineParsers(ComponentParserRegistry& registry);
+
+	unsigned int ParseLayerMask(const string& layers); // Comma separated collision layer names. Colliders without any are in the default layer
+}
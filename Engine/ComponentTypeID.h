@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+
+typedef unsigned long long ComponentMask; // One bit per component index on a GameObject
+
+const int MAX_COMPONENTS_PER_GAMEOBJECT = 63; // The last bit is kept free so an all set mask can mean 'not looked up yet'
+const ComponentMask COMPONENT_MASK_UNKNOWN = ~0ull;
+
+// What a component can do, worked out once when it's added to a GameObject
+enum ComponentCapability
+{
+	eUpdateable = 1 << 0,
+	eDrawable = 1 << 1,
+	eMessageable = 1 << 2
+};
+
+inline int NextComponentTypeID()
+{
+	static std::atomic<int> nextTypeID(0);
+	return nextTypeID++;
+}
+
+// Every type components are looked up by, including base classes and interfaces, gets a small unique ID the first time it's used.
+// Nothing needs registering, so component types added by game code work the same way.
+template<class T>
+int GetComponentTypeID()
+{
+	static const int typeID = NextComponentTypeID();
+	return typeID;
+}
@@ -36,6 +36,18 @@ static float AI_PROJECTILE_DAMAGE = 20; // Default 20
 static float AI_PROJECTILE_SPEED = 50; // Default 50
 static float AI_LATERAL_MAX_SPEED = 300; // Default is 300
 
+static int PHYSICS_SOLVER_ITERATIONS = 8; // Default is 8. Contacts are warm started so resting contacts converge in a few iterations
+
+static float PHYSICS_SLEEP_LINEAR_TOLERANCE = 5.0f; // Default is 5. Bodies moving slower than this are considered resting
+static float PHYSICS_SLEEP_ANGULAR_TOLERANCE = 0.035f; // Default is 0.035 (2 degrees). In radians per second
+static float PHYSICS_TIME_TO_SLEEP = 0.5f; // Default is 0.5. How long every body in an island has to rest before the island sleeps
+
+static float PHYSICS_FIXED_TIMESTEP = 1.0f / 60.0f; // Default is 1/60. The scene is always simulated in steps of exactly this length
+static int PHYSICS_MAX_STEPS_PER_FRAME = 5; // Default is 5. Time beyond this many steps is dropped so a slow frame can't cause slower frames
+
+static int PHYSICS_MAX_CCD_SUBSTEPS = 4; // Default is 4. Most impacts a continuous body can resolve in one step before it stops for the step
+static float PHYSICS_CCD_SLOP = 0.5f; // Default is 0.5. How far into a collider a continuous body is placed at the time of impact
+
 static float GRAVITY_SCALE = 20.0f; // Default is 20
 static Vec2 GRAVITY_VECTOR(0, 9.81f * GRAVITY_SCALE); // Default is 9.81 * SCALE
 
@@ -48,6 +60,15 @@ static constexpr int MAX_QUADTREE_LEVELS = 5;
 
 static constexpr int MAX_POLY_VERTEX_COUNT = 64;
 
+static constexpr float BROADPHASE_AABB_MARGIN = 10.0f; // How far a collider can move before it has to be re-inserted into the broadphase
+static constexpr int PHYSICS_NARROWPHASE_MIN_BATCH_SIZE = 64; // Fewest broadphase pairs worth handing to another thread
+static constexpr int UPDATE_PARALLEL_GRAIN_SIZE = 32; // Fewest components of a parallel type worth handing to another thread
+static constexpr size_t SCENE_ARENA_BLOCK_SIZE = 64 * 1024; // Size of each block a scene allocates its objects from
+static constexpr int OBJECT_POOL_GROW_AMOUNT = 16; // Objects added at a time by pools that grow linearly
+static constexpr int OBJECT_POOL_MAX_CAPACITY = 1024; // Most objects a growing pool will ever hold
+static constexpr int ENTITY_TABLE_CHUNK_SIZE = 1024; // Slots the entity table adds at a time. Slots never move once added
+static constexpr int ENTITY_TABLE_MAX_CHUNKS = 1024; // Most chunks the entity table can hold, so over a million objects alive at once
+
 static constexpr float PI = 3.141592741f;
 
 #pragma endregion
@@ -90,18 +111,72 @@ enum MessageType
 {
 	eUpdateAnimationSequence,
 	eAddForce,
-	eCollision,
 	eRecieveDamage,
-	eSetActive
+	eSetActive,
+	eMessageTypeCount
+};
+
+// Order the scene updates component types in. Types with the same order run in the order they were first added to the scene
+enum UpdateOrder
+{
+	eUpdateOrderGamePlay, // Reads input and the results of the physics step
+	eUpdateOrderProjectiles,
+	eUpdateOrderDefault,
+	eUpdateOrderAnimation, // Runs once gameplay has picked what to play
+	eUpdateOrderCamera, // Follows objects once they have finished moving
+	eUpdateOrderGUI
+};
+
+// Whether a component type's updates can be spread over the job system
+enum UpdateThreading
+{
+	eUpdateSerial, // Updated on the calling thread in UpdateOrder. Free to touch anything
+	eUpdateParallel, // Only touches the component's own state, so every component of the type can update at once, alongside the physics step
+	eUpdateParallelAfterPhysics // As above, but reads transforms that physics moves so has to wait for the step to finish
+};
+
+enum PoolGrowthPolicy
+{
+	ePoolGrowNever, // Acquiring fails once every object is in use
+	ePoolGrowLinear, // Adds OBJECT_POOL_GROW_AMOUNT objects at a time
+	ePoolGrowDouble // Doubles in size. Fewest growths for pools that were badly undersized
+};
+
+enum CollisionEventType
+{
+	eCollisionBegin = 1 << 0, // The pair started touching this step
+	eCollisionPersist = 1 << 1, // The pair was already touching. Only queued when something has subscribed to them
+	eCollisionEnd = 1 << 2 // The pair stopped touching, or one of them was deactivated
 };
 
 enum ColliderType 
 {
 	eCircle,
 	ePolygon,
+	eBox, // Polygons with four axis aligned faces in model space. Collide with the polygon routines unless they are also axis aligned in world space
 	eColliderTypeCount
 };
 
+// Layers a collider can be in. Colliders store the layers they are in as a bitmask, so there can be at most 32
+enum CollisionLayer
+{
+	eLayerDefault,
+	eLayerLevel, // Tiles and the level bounds
+	eLayerPlayer,
+	eLayerEnemy,
+	eLayerProjectile,
+	eCollisionLayerCount
+};
+
+static std::map<std::string, CollisionLayer> CollisionLayerNames =
+{
+	{ "Default",		eLayerDefault },
+	{ "Level",			eLayerLevel },
+	{ "Player",			eLayerPlayer },
+	{ "Enemy",			eLayerEnemy },
+	{ "Projectile",		eLayerProjectile },
+};
+
 enum CollisionType 
 {
 	eCircletoCircle,
@@ -168,30 +243,29 @@ struct AnimationDesc
 	}
 };
 
+// Properties of a rigidbody that the integrator never reads. Stored alongside the hot arrays in RigidBodyWorld
 struct RigidBodyData 
 {
-	Vec2 velocity;
-
-	float angularVelocity;
-	float torque;
-
-	Vec2 force;
-
 	Mat2 orientationMatrix;
 
-	// Set by rigidbody
+	// Set by collider
 	float intertia;  // moment of inertia
-	float inverseInertia; // inverse inertia
 	float mass;  // mass
-	float inverseMass; // inverse masee
 
 	float staticFriction;
 	float dynamicFriction;
 	float restitution;
 
-	RigidBodyData(Vec2 velocity, float angularVelocity, float torque, Vec2 force, float staticFriction, float dynamicFrication, float restituation)
-		: velocity(velocity), angularVelocity(angularVelocity), torque(torque), force(force), 
-		staticFriction(staticFriction), dynamicFriction(dynamicFrication), restitution(restituation)
+	bool rotationLocked;
+	bool continuous;
+	bool awake;
+	bool sleepingAllowed;
+	float sleepTime;
+
+	RigidBodyData(float staticFriction, float dynamicFrication, float restituation)
+		: orientationMatrix(0.0f), intertia(0), mass(0),
+		staticFriction(staticFriction), dynamicFriction(dynamicFrication), restitution(restituation),
+		rotationLocked(false), continuous(false), awake(true), sleepingAllowed(true), sleepTime(0)
 	{
 
 	}
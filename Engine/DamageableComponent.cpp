@@ -1,4 +1,5 @@
 #include "DamageableComponent.h"
+#include "MessageBus.h"
 
 DamageableComponent::DamageableComponent(float startHealth, std::string hitNoise) : mHitNoise(hitNoise)
 {
@@ -39,3 +40,8 @@ void DamageableComponent::RecieveMessage(IMessage & msg)
 			break;
 	}
 }
+
+void DamageableComponent::SubscribeToMessages(MessageBus & bus, GameObject * owner)
+{
+	bus.Subscribe(MessageType::eRecieveDamage, owner, this, this);
+}
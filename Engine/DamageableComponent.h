@@ -15,6 +15,7 @@ public:
 
 	void RecieveDamage(float dmg);
 	virtual void RecieveMessage(IMessage &msg) override;
+	virtual void SubscribeToMessages(MessageBus& bus, GameObject* owner) override;
 
 	bool IsDead() { return mIsDead; }
 
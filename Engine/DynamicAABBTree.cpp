@@ -0,0 +1,353 @@
+#include "DynamicAABBTree.h"
+
+DynamicAABBTree::DynamicAABBTree() : mRoot(-1), mFreeList(-1)
+{
+}
+
+int DynamicAABBTree::CreateProxy(const AABB & aabb, int element)
+{
+	int proxyID = AllocateNode();
+
+	// Fatten the bounds so the proxy can move a little without having to be re-inserted
+	mNodes[proxyID].aabb = aabb.Expanded(BROADPHASE_AABB_MARGIN);
+	mNodes[proxyID].element = element;
+	mNodes[proxyID].height = 0;
+
+	InsertLeaf(proxyID);
+
+	return proxyID;
+}
+
+void DynamicAABBTree::DestroyProxy(int proxyID)
+{
+	assert(proxyID >= 0 && proxyID < (int)mNodes.size() && mNodes[proxyID].IsLeaf());
+
+	RemoveLeaf(proxyID);
+	FreeNode(proxyID);
+}
+
+bool DynamicAABBTree::MoveProxy(int proxyID, const AABB & aabb)
+{
+	assert(proxyID >= 0 && proxyID < (int)mNodes.size() && mNodes[proxyID].IsLeaf());
+
+	// Still inside the fat bounds so the tree doesn't need to change
+	if (mNodes[proxyID].aabb.Contains(aabb))
+		return false;
+
+	RemoveLeaf(proxyID);
+	mNodes[proxyID].aabb = aabb.Expanded(BROADPHASE_AABB_MARGIN);
+	InsertLeaf(proxyID);
+
+	return true;
+}
+
+void DynamicAABBTree::Query(const AABB & aabb, std::vector<int>& elements) const
+{
+	if (mRoot == -1)
+		return;
+
+	mQueryStack.clear();
+	mQueryStack.push_back(mRoot);
+
+	while (!mQueryStack.empty())
+	{
+		const TreeNode& node = mNodes[mQueryStack.back()];
+		mQueryStack.pop_back();
+
+		if (!node.aabb.Overlaps(aabb))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			elements.push_back(node.element);
+		}
+		else
+		{
+			mQueryStack.push_back(node.child1);
+			mQueryStack.push_back(node.child2);
+		}
+	}
+}
+
+int DynamicAABBTree::GetHeight() const
+{
+	return mRoot == -1 ? 0 : mNodes[mRoot].height;
+}
+
+int DynamicAABBTree::AllocateNode()
+{
+	// See if we can pop a free node from the list.
+	int nodeIndex = mFreeList;
+	if (nodeIndex != -1)
+		mFreeList = mNodes[mFreeList].parent;
+	else
+	{
+		// If the free list was empty, add a new node.
+		mNodes.push_back(TreeNode());
+		nodeIndex = (int)mNodes.size() - 1;
+	}
+
+	mNodes[nodeIndex].element = -1;
+	mNodes[nodeIndex].parent = -1;
+	mNodes[nodeIndex].child1 = -1;
+	mNodes[nodeIndex].child2 = -1;
+	mNodes[nodeIndex].height = 0;
+
+	return nodeIndex;
+}
+
+void DynamicAABBTree::FreeNode(int nodeIndex)
+{
+	mNodes[nodeIndex].parent = mFreeList;
+	mNodes[nodeIndex].height = -1;
+	mFreeList = nodeIndex;
+}
+
+void DynamicAABBTree::InsertLeaf(int leaf)
+{
+	if (mRoot == -1)
+	{
+		mRoot = leaf;
+		mNodes[mRoot].parent = -1;
+		return;
+	}
+
+	// Walk down the tree choosing the child that increases the total perimeter the least
+	AABB leafAABB = mNodes[leaf].aabb;
+	int index = mRoot;
+	while (!mNodes[index].IsLeaf())
+	{
+		int child1 = mNodes[index].child1;
+		int child2 = mNodes[index].child2;
+
+		float perimeter = mNodes[index].aabb.GetPerimeter();
+		float combinedPerimeter = Combine(mNodes[index].aabb, leafAABB).GetPerimeter();
+
+		// Cost of creating a new parent for this node and the new leaf
+		float cost = 2.0f * combinedPerimeter;
+
+		// Minimum cost of pushing the leaf further down the tree
+		float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+		float cost1 = Combine(leafAABB, mNodes[child1].aabb).GetPerimeter() + inheritanceCost;
+		if (!mNodes[child1].IsLeaf())
+			cost1 -= mNodes[child1].aabb.GetPerimeter();
+
+		float cost2 = Combine(leafAABB, mNodes[child2].aabb).GetPerimeter() + inheritanceCost;
+		if (!mNodes[child2].IsLeaf())
+			cost2 -= mNodes[child2].aabb.GetPerimeter();
+
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int sibling = index;
+
+	// Create a new parent for the sibling and the leaf
+	int oldParent = mNodes[sibling].parent;
+	int newParent = AllocateNode();
+	mNodes[newParent].parent = oldParent;
+	mNodes[newParent].aabb = Combine(leafAABB, mNodes[sibling].aabb);
+	mNodes[newParent].height = mNodes[sibling].height + 1;
+	mNodes[newParent].child1 = sibling;
+	mNodes[newParent].child2 = leaf;
+	mNodes[sibling].parent = newParent;
+	mNodes[leaf].parent = newParent;
+
+	if (oldParent != -1)
+	{
+		if (mNodes[oldParent].child1 == sibling)
+			mNodes[oldParent].child1 = newParent;
+		else
+			mNodes[oldParent].child2 = newParent;
+	}
+	else // The sibling was the root
+	{
+		mRoot = newParent;
+	}
+
+	// Walk back up the tree fixing heights and bounds
+	index = mNodes[leaf].parent;
+	while (index != -1)
+	{
+		index = Balance(index);
+
+		int child1 = mNodes[index].child1;
+		int child2 = mNodes[index].child2;
+
+		mNodes[index].height = 1 + std::max(mNodes[child1].height, mNodes[child2].height);
+		mNodes[index].aabb = Combine(mNodes[child1].aabb, mNodes[child2].aabb);
+
+		index = mNodes[index].parent;
+	}
+}
+
+void DynamicAABBTree::RemoveLeaf(int leaf)
+{
+	if (leaf == mRoot)
+	{
+		mRoot = -1;
+		return;
+	}
+
+	int parent = mNodes[leaf].parent;
+	int grandParent = mNodes[parent].parent;
+	int sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+	if (grandParent != -1)
+	{
+		// Destroy the parent and connect the sibling to the grand parent
+		if (mNodes[grandParent].child1 == parent)
+			mNodes[grandParent].child1 = sibling;
+		else
+			mNodes[grandParent].child2 = sibling;
+
+		mNodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		// Adjust ancestor bounds
+		int index = grandParent;
+		while (index != -1)
+		{
+			index = Balance(index);
+
+			int child1 = mNodes[index].child1;
+			int child2 = mNodes[index].child2;
+
+			mNodes[index].aabb = Combine(mNodes[child1].aabb, mNodes[child2].aabb);
+			mNodes[index].height = 1 + std::max(mNodes[child1].height, mNodes[child2].height);
+
+			index = mNodes[index].parent;
+		}
+	}
+	else // The parent was the root so the sibling becomes the root
+	{
+		mRoot = sibling;
+		mNodes[sibling].parent = -1;
+		FreeNode(parent);
+	}
+}
+
+int DynamicAABBTree::Balance(int iA)
+{
+	TreeNode* A = &mNodes[iA];
+	if (A->IsLeaf() || A->height < 2)
+		return iA;
+
+	int iB = A->child1;
+	int iC = A->child2;
+	TreeNode* B = &mNodes[iB];
+	TreeNode* C = &mNodes[iC];
+
+	int balance = C->height - B->height;
+
+	// Rotate C up
+	if (balance > 1)
+	{
+		int iF = C->child1;
+		int iG = C->child2;
+		TreeNode* F = &mNodes[iF];
+		TreeNode* G = &mNodes[iG];
+
+		// Swap A and C
+		C->child1 = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		// A's old parent should point to C
+		if (C->parent != -1)
+		{
+			if (mNodes[C->parent].child1 == iA)
+				mNodes[C->parent].child1 = iC;
+			else
+				mNodes[C->parent].child2 = iC;
+		}
+		else
+		{
+			mRoot = iC;
+		}
+
+		// Rotate the taller of C's children up
+		if (F->height > G->height)
+		{
+			C->child2 = iF;
+			A->child2 = iG;
+			G->parent = iA;
+			A->aabb = Combine(B->aabb, G->aabb);
+			C->aabb = Combine(A->aabb, F->aabb);
+
+			A->height = 1 + std::max(B->height, G->height);
+			C->height = 1 + std::max(A->height, F->height);
+		}
+		else
+		{
+			C->child2 = iG;
+			A->child2 = iF;
+			F->parent = iA;
+			A->aabb = Combine(B->aabb, F->aabb);
+			C->aabb = Combine(A->aabb, G->aabb);
+
+			A->height = 1 + std::max(B->height, F->height);
+			C->height = 1 + std::max(A->height, G->height);
+		}
+
+		return iC;
+	}
+
+	// Rotate B up
+	if (balance < -1)
+	{
+		int iD = B->child1;
+		int iE = B->child2;
+		TreeNode* D = &mNodes[iD];
+		TreeNode* E = &mNodes[iE];
+
+		// Swap A and B
+		B->child1 = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		// A's old parent should point to B
+		if (B->parent != -1)
+		{
+			if (mNodes[B->parent].child1 == iA)
+				mNodes[B->parent].child1 = iB;
+			else
+				mNodes[B->parent].child2 = iB;
+		}
+		else
+		{
+			mRoot = iB;
+		}
+
+		// Rotate the taller of B's children up
+		if (D->height > E->height)
+		{
+			B->child2 = iD;
+			A->child1 = iE;
+			E->parent = iA;
+			A->aabb = Combine(C->aabb, E->aabb);
+			B->aabb = Combine(A->aabb, D->aabb);
+
+			A->height = 1 + std::max(C->height, E->height);
+			B->height = 1 + std::max(A->height, D->height);
+		}
+		else
+		{
+			B->child2 = iE;
+			A->child1 = iD;
+			D->parent = iA;
+			A->aabb = Combine(C->aabb, D->aabb);
+			B->aabb = Combine(A->aabb, E->aabb);
+
+			A->height = 1 + std::max(C->height, D->height);
+			B->height = 1 + std::max(A->height, E->height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
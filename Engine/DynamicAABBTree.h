@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "IBroadphase.h"
+
+struct TreeNode
+{
+	AABB aabb; // Fat bounds for leaves. Union of both children for branches
+	int element; // Stores the index to the element. -1 for branches
+	int parent; // Stores either the parent node or the next free node if this node has been removed
+	int child1;
+	int child2;
+	int height; // Leaf = 0, free node = -1
+
+	bool IsLeaf() const { return child1 == -1; }
+};
+
+// Bounding volume hierarchy where every leaf holds a slightly enlarged copy of an elements bounds.
+// Elements only get re-inserted when they move outside of their enlarged bounds, so small movements are free.
+class DynamicAABBTree : public IBroadphase
+{
+public:
+	DynamicAABBTree();
+
+	virtual int CreateProxy(const AABB& aabb, int element) override;
+	virtual void DestroyProxy(int proxyID) override;
+	virtual bool MoveProxy(int proxyID, const AABB& aabb) override;
+
+	virtual void Query(const AABB& aabb, std::vector<int>& elements) const override;
+	virtual const AABB& GetFatAABB(int proxyID) const override { return mNodes[proxyID].aabb; }
+
+	int GetHeight() const; // Gets the height of the tree. A balanced tree is roughly log2 of the number of proxies
+
+private:
+	int AllocateNode(); // Pops a node from the free list or grows the node pool.
+	void FreeNode(int nodeIndex); // Pushes a node to the free list.
+
+	void InsertLeaf(int leaf); // Finds the best sibling for the leaf and inserts it next to it.
+	void RemoveLeaf(int leaf); // Removes the leaf from the hierarchy, collapsing its parent.
+	int Balance(int nodeIndex); // Performs a left or right rotation if the node is imbalanced. Returns the new root of the sub tree.
+
+	std::vector<TreeNode>			mNodes;
+	mutable std::vector<int>		mQueryStack; // Reused between queries to avoid allocating every call
+
+	int								mRoot;
+	int								mFreeList; // Stores an index to the first free (unused) node.
+};
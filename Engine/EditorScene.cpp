@@ -31,14 +31,14 @@ void EditorScene::CacheComponents(shared_ptr<GameObject> gameObj)
 
 		if (drawableComponent != nullptr)
 		{
-			mRenderLayers[drawableComponent->RenderLayer].push_back(gameObj);
+			mRenderLayers[drawableComponent->RenderLayer].push_back(gameObj.get());
 		}
 	}
 
 	ProjectileManagerComponent* goProjManager = gameObj->GetComponent<ProjectileManagerComponent>();
-	if (goProjManager != nullptr)
+	if (goProjManager != nullptr && AddPool(goProjManager->GetPool()))
 	{
-		for (auto go : goProjManager->GetAllInactiveGameObjects())
+		for (auto go : goProjManager->GetPool()->GetAllGameObjects())
 		{
 			mGameObjects.push_back(go);
 		}
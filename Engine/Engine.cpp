@@ -13,6 +13,9 @@ Engine::Engine(MainWindow& wnd, int width, int height, std::string resourcesPath
 
 	Audio::Instance().CreateSoundEffects(ApplicationValues::Instance().ResourcesPath);
 
+	// The engine's own component types are registered by the registry itself
+	ComponentParsers::RegisterGameParsers(ComponentParserRegistry::Instance());
+
 	//SceneBuilder::InitaliseGameplayValues(ApplicationValues::Instance().ResourcesPath + "\\Levels\\Prefabs.xml"); //BROKEN
 
 	ScenePersistentValues::Instance().Values["CurrentLevel"].reset(new PersistentValue<float>(1));
@@ -40,7 +43,8 @@ void Engine::PlayStarted()
 
 void Engine::PlayStopped()
 {
-	mPlayScene = nullptr;
+	mSceneLoader.Cancel();
+	ReleaseScene(mPlayScene);
 	EngineState = EngineState::eEditor;
 }
 
@@ -49,8 +53,23 @@ void Engine::LoadNewScene(std::string scenePath)
 	InitaliseEditorScene(scenePath);
 }
 
+int Engine::CompileScenes()
+{
+	return SceneCompiler::CompileDirectory(ApplicationValues::Instance().ResourcesPath + "\\Levels");
+}
+
+SceneLoadBenchmark Engine::BenchmarkSceneLoad(std::string sceneName, int iterations)
+{
+	string scenePath = ApplicationValues::Instance().ResourcesPath + "\\Levels\\" + sceneName + ".xml";
+
+	IGraphics* graphics = mGraphics;
+	return SceneBuilder::BenchmarkSceneLoad([graphics] { return make_shared<PlayScene>(new PlayCamera(graphics)); }, scenePath, iterations);
+}
+
 void Engine::Update()
 {
+	SwapLoadedScene();
+
 	mGraphics->BeginFrame();
 
 	// If game is playing
@@ -64,8 +83,9 @@ void Engine::Update()
 
 Engine::~Engine()
 {
-	mEditorScene = nullptr;
-	mPlayScene = nullptr;
+	mSceneLoader.Cancel();
+	ReleaseScene(mEditorScene);
+	ReleaseScene(mPlayScene);
 
 	mGraphics->Destroy();
 }
@@ -80,7 +100,12 @@ void Engine::UpdateScene()
 		{
 			LoadPlayScene(SceneManagement::Instance().NewSceneName);
 		}
-		mPlayScene->Update(deltaTime);
+
+		// The current scene is paused while the next one is built, so nothing it does can change what the loader thread reads
+		if (!mSceneLoader.IsLoading())
+		{
+			mPlayScene->Update(deltaTime);
+		}
 	}
 	else
 	{
@@ -93,6 +118,11 @@ void Engine::DrawScene()
 	if (EngineState == EngineState::ePlayMode)
 	{
 		mPlayScene->Draw();
+
+		if (mSceneLoader.IsLoading())
+		{
+			DrawLoadingProgress();
+		}
 	}
 	else
 	{
@@ -110,8 +140,52 @@ void Engine::LoadPlayScene(std::string sceneName)
 
 	EngineState = EngineState::ePlayMode;
 
-	mPlayScene = make_shared<PlayScene>(new PlayCamera(mGraphics));
-	SceneBuilder::BuildScene(mPlayScene, scenePath);
+	// Built on the loader thread and swapped in at the start of the first frame after it is finished
+	mSceneLoader.Cancel();
+	mSceneLoader.Load(make_shared<PlayScene>(new PlayCamera(mGraphics)), scenePath);
+}
+
+void Engine::SwapLoadedScene()
+{
+	if (!mSceneLoader.IsReady())
+		return;
+
+	// The scene being replaced is destroyed here, before anything of the frame has run
+	shared_ptr<IScene> scene = mSceneLoader.TakeScene();
+	ReleaseScene(mPlayScene);
+	mPlayScene = scene;
+}
+
+void Engine::ReleaseScene(shared_ptr<IScene>& scene)
+{
+	if (scene == nullptr)
+		return;
+
+	// Read while the scene is still alive, as its arena's stats are reset once the arena is released
+	const SceneArenaStats& arenaStats = scene->GetArena().GetStats();
+	EngineLog::Write("Releasing scene: " + to_string(arenaStats.allocationCount) + " allocations, " + to_string(arenaStats.bytesAllocated) +
+		" bytes in " + to_string(arenaStats.blockCount) + " arena blocks");
+
+	// A pool that grew, or peaked well below its capacity, wants a different size in the scene file
+	for (auto& pool : scene->GetPools())
+	{
+		const ObjectPoolStats& poolStats = pool->GetStats();
+		EngineLog::Write("  Pool '" + pool->GetType() + "': " + to_string(poolStats.capacity) + " objects, peak of " + to_string(poolStats.peakActiveCount) +
+			" in use, " + to_string(poolStats.activeCount) + " still in use, " + to_string(poolStats.acquireCount) + " acquired, grew " +
+			to_string(poolStats.growCount) + " times, " + to_string(poolStats.failedAcquireCount) + " failed and " + to_string(poolStats.quotaRejectCount) + " over quota");
+	}
+
+	scene = nullptr;
+}
+
+void Engine::DrawLoadingProgress()
+{
+	stringstream stream;
+	stream << "LOADING " << (int)(mSceneLoader.GetProgress() * 100) << "%";
+
+	float rgb[3] = { 1, 1, 1 };
+	Vec2 centre = Vec2(ApplicationValues::Instance().ScreenWidth / 2.0f, ApplicationValues::Instance().ScreenHeight / 2.0f);
+	mGraphics->DrawText(stream.str(), centre, 0, rgb, 1, Vec2(0, 0));
 }
 
 void Engine::LoadPlayScene()
@@ -120,8 +194,18 @@ void Engine::LoadPlayScene()
 
 	EngineState = EngineState::ePlayMode;
 
+	ReleaseScene(mPlayScene);
 	mPlayScene = make_shared<PlayScene>(new PlayCamera(mGraphics));
-	SceneBuilder::BuildScene(mPlayScene, mCurrentScenePath);
+
+	// Starts from the scene the editor already read rather than going back to the disk
+	if (mEditorSnapshot != nullptr)
+	{
+		SceneBuilder::BuildSceneFromSnapshot(mPlayScene, *mEditorSnapshot);
+	}
+	else
+	{
+		SceneBuilder::BuildScene(mPlayScene, mCurrentScenePath);
+	}
 }
 
 void Engine::InitaliseEditorScene(std::string scenePath)
@@ -129,10 +213,13 @@ void Engine::InitaliseEditorScene(std::string scenePath)
 	EngineState = EngineState::eEditor;
 	mCurrentScenePath = scenePath;
 
+	ReleaseScene(mEditorScene);
 	mEditorScene = make_shared<EditorScene>(new EditorCamera(mGraphics));
+	mEditorSnapshot = nullptr;
 
 	if (!scenePath.empty())
 	{
-		SceneBuilder::BuildScene(mEditorScene, scenePath);
+		mEditorSnapshot = SceneBuilder::CaptureScene(scenePath);
+		SceneBuilder::BuildSceneFromSnapshot(mEditorScene, *mEditorSnapshot);
 	}
 }
\ No newline at end of file
@@ -2,9 +2,12 @@
 
 #include "FrameTimer.h"
 #include "MainWindow.h"
+#include "EngineLog.h"
 
 #include "SceneBuilder.h"
+#include "GameComponentParsers.h"
 #include "SceneManagement.h"
+#include "SceneLoader.h"
 #include "ScenePersistentValues.h"
 
 #include "PlayScene.h"
@@ -29,6 +32,9 @@ public:
 
 	void LoadNewScene(std::string scenePath);
 
+	int CompileScenes(); // Compiles every scene in the Levels folder. Returns how many were compiled
+	SceneLoadBenchmark BenchmarkSceneLoad(std::string sceneName, int iterations); // Times building a play scene from its XML against its compiled scene
+
 	void Update();
 
 	~Engine();
@@ -40,15 +46,20 @@ public:
 private:
 	void DrawScene();
 	void UpdateScene();
+	void SwapLoadedScene(); // Called between frames
+	void ReleaseScene(shared_ptr<IScene>& scene); // Logs how much memory the scene and its pools used and lets go of it
+	void DrawLoadingProgress();
 
 	void LoadPlayScene(std::string sceneName);
 	void LoadPlayScene();
 	void InitaliseEditorScene(std::string sceneName);
 
-	FrameTimer					mFrameTimer;
-	shared_ptr<IScene>			mEditorScene;
-	shared_ptr<IScene>			mPlayScene;
-	IGraphics*					mGraphics;
+	FrameTimer							mFrameTimer;
+	shared_ptr<IScene>					mEditorScene;
+	shared_ptr<IScene>					mPlayScene;
+	SceneLoader							mSceneLoader; // Builds the next level while the current one is still drawn
+	IGraphics*							mGraphics;
 
-	string						mCurrentScenePath;
+	string								mCurrentScenePath;
+	shared_ptr<const SceneSnapshot>		mEditorSnapshot; // The open scene as it was read, so each play starts from it without touching the disk
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "EngineLog.h"
+
+#include "WinDefines.h"
+
+#include <mutex>
+
+void EngineLog::Write(const string & message)
+{
+	// Lines written by different threads at once would otherwise be interleaved
+	static std::mutex writeMutex;
+	std::lock_guard<std::mutex> lock(writeMutex);
+
+	string line = message + "\n";
+	OutputDebugStringA(line.c_str());
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+// Where the engine reports what it is doing outside of errors, which are thrown. Every line goes to the debugger's output window.
+// Safe to call from any thread, so scenes being built or destroyed on the loader thread can report too
+namespace EngineLog
+{
+	void Write(const string& message); // One line. The newline is added
+}
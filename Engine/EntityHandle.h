@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// Refers to a GameObject through the entity table without owning it. The generation changes every time the object in a slot is
+// destroyed, so a handle to a destroyed object resolves to null instead of to whatever takes its place
+struct EntityHandle
+{
+	uint32_t index = 0;
+	uint32_t generation = 0; // Generations start at 1, so a default constructed handle is never valid
+
+	bool IsNull() const { return generation == 0; }
+
+	bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
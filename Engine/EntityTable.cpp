@@ -0,0 +1,82 @@
+#include "EntityTable.h"
+
+#include <cassert>
+
+EntityTable::EntityTable() : mSlotCount(0), mCount(0)
+{
+}
+
+EntityTable::~EntityTable()
+{
+	for (EntitySlot* chunk : mChunks)
+		delete[] chunk;
+}
+
+EntityHandle EntityTable::Create(GameObject * gameObject)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	int index = mFreeList;
+	if (index != -1)
+	{
+		mFreeList = GetSlot(index).nextFree;
+	}
+	else
+	{
+		index = (int)mSlotCount.load(std::memory_order_relaxed);
+
+		int chunk = index / ENTITY_TABLE_CHUNK_SIZE;
+		if (chunk >= ENTITY_TABLE_MAX_CHUNKS)
+			throw std::exception("The entity table is full.");
+
+		if (mChunks[chunk] == nullptr)
+		{
+			mChunks[chunk] = new EntitySlot[ENTITY_TABLE_CHUNK_SIZE];
+			for (int i = 0; i < ENTITY_TABLE_CHUNK_SIZE; i++)
+			{
+				mChunks[chunk][i].gameObject.store(nullptr, std::memory_order_relaxed);
+				mChunks[chunk][i].generation.store(1, std::memory_order_relaxed);
+				mChunks[chunk][i].nextFree = -1;
+			}
+		}
+
+		// Published last so other threads only ever see slots that are ready
+		mSlotCount.store(index + 1, std::memory_order_release);
+	}
+
+	EntitySlot& slot = GetSlot(index);
+	slot.gameObject.store(gameObject, std::memory_order_relaxed);
+	slot.nextFree = -1;
+
+	mCount++;
+
+	EntityHandle handle;
+	handle.index = (uint32_t)index;
+	handle.generation = slot.generation.load(std::memory_order_relaxed);
+	return handle;
+}
+
+void EntityTable::Destroy(EntityHandle handle)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Called from GameObject's destructor, where throwing would terminate the game, so a stale handle is only caught in debug builds
+	if (Resolve(handle) == nullptr)
+	{
+		assert(!"This entity has already been destroyed");
+		return;
+	}
+
+	EntitySlot& slot = GetSlot(handle.index);
+	slot.gameObject.store(nullptr, std::memory_order_relaxed);
+
+	// Skip 0 when the generation wraps so a default constructed handle can never match
+	uint32_t generation = handle.generation + 1;
+	if (generation == 0)
+		generation = 1;
+	slot.generation.store(generation, std::memory_order_release);
+
+	slot.nextFree = mFreeList;
+	mFreeList = (int)handle.index;
+	mCount--;
+}
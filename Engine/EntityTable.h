@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "EntityHandle.h"
+#include "Consts.h"
+
+class GameObject;
+
+// Every GameObject that exists is registered here when it is constructed and removed when it is destroyed.
+// Systems hold EntityHandles and resolve them with a bounds and generation check, rather than keeping
+// shared_ptrs whose reference counts have to change every time they are copied.
+// Objects can be created and destroyed on any thread, since scenes are built on a loader thread. Slots are stored in
+// chunks that never move, so resolving a handle never has to lock
+class EntityTable
+{
+public:
+	static EntityTable& Instance()
+	{
+		static EntityTable Instance;
+		return Instance;
+	}
+
+	EntityHandle Create(GameObject* gameObject); // Called by GameObject's constructor
+	void Destroy(EntityHandle handle); // Called by GameObject's destructor. Every handle to the object goes stale. Asserts on a stale handle rather than throwing
+
+	GameObject* Resolve(EntityHandle handle) const // Null if the object has been destroyed
+	{
+		if (handle.index >= mSlotCount.load(std::memory_order_acquire))
+			return nullptr;
+
+		const EntitySlot& slot = GetSlot(handle.index);
+		if (slot.generation.load(std::memory_order_acquire) != handle.generation)
+			return nullptr;
+
+		return slot.gameObject.load(std::memory_order_relaxed);
+	}
+
+	bool IsAlive(EntityHandle handle) const { return Resolve(handle) != nullptr; }
+	int GetCount() const { return mCount.load(std::memory_order_relaxed); }
+
+private:
+	EntityTable();
+	~EntityTable();
+
+	// The generation moves on when an object is destroyed rather than when its slot is reused, so a stale handle
+	// stops resolving straight away and a slot being handed out on another thread is never mistaken for the old object
+	struct EntitySlot
+	{
+		std::atomic<GameObject*>	gameObject;
+		std::atomic<uint32_t>		generation;
+		int							nextFree; // Next free slot while this one is unused
+	};
+
+	EntitySlot& GetSlot(uint32_t index) const { return mChunks[index / ENTITY_TABLE_CHUNK_SIZE][index % ENTITY_TABLE_CHUNK_SIZE]; }
+
+	EntitySlot*						mChunks[ENTITY_TABLE_MAX_CHUNKS] = { };
+	std::atomic<uint32_t>			mSlotCount;
+	int								mFreeList = -1;
+	std::atomic<int>				mCount;
+	std::mutex						mMutex; // Held while creating and destroying
+};
@@ -15,7 +15,8 @@ void GUIButtonComponent::Update(float deltaTime)
 	if (mClicked)
 		return;
 
-	if (Mouse::Instance().LeftIsPressed() && !mIsPressed)
+	// A click that was over before this step still counts
+	if ((Mouse::Instance().LeftIsPressed() || Mouse::Instance().LeftWasPressed()) && !mIsPressed)
 	{
 		mIsPressed = true;
 
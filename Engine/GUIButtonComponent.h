@@ -14,6 +14,7 @@ public:
 	~GUIButtonComponent();
 
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderGUI; }
 
 	bool Clicked() { return mClicked; }
 	void Reset() {	mClicked = false; mIsPressed = false; }
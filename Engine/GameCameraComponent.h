@@ -14,6 +14,7 @@ public:
 	void SetLevelBounds(float leftBound, float rightBound, float botBound, float topBound) { mLevelLeftBound = leftBound; mLevelRightBound = rightBound; mLevelBottomBound = botBound; mLevelTopBound = topBound; }
 
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderCamera; }
 
 private:
 	TransformComponent *	mTransform;
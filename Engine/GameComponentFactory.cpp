@@ -46,10 +46,9 @@ ProjectileComponent * ComponentFactory::MakeProjectileComponent(std::string affe
 	return projectileComponent;
 }
 
-ProjectileManagerComponent * ComponentFactory::MakeProjectileManagerComponent(std::vector<shared_ptr<GameObject>> projectiles)
+ProjectileManagerComponent * ComponentFactory::MakeProjectileManagerComponent(shared_ptr<ObjectPool> pool, int quota)
 {
-	ProjectileManagerComponent* projComponent = new ProjectileManagerComponent;
-	projComponent->AddCreatedGameObjects(projectiles);
+	ProjectileManagerComponent* projComponent = new ProjectileManagerComponent(pool, quota);
 	return projComponent;
 }
 
@@ -19,7 +19,7 @@ namespace ComponentFactory
 	DamageableComponent * MakeDamageableComponent(float startHealth, std::string hitNoise);
 	
 	ProjectileComponent * MakeProjectileComponent(std::string affectedTag, float lifeSpan, float dmg);
-	ProjectileManagerComponent * MakeProjectileManagerComponent(std::vector<shared_ptr<GameObject>> projectiles);
+	ProjectileManagerComponent * MakeProjectileManagerComponent(shared_ptr<ObjectPool> pool, int quota);
 	
 	AIAgentComponent * MakeAIAgentComponent(TransformComponent* trans, SpriteAnimatorComponent* anim, RigidBodyComponent* rb, DamageableComponent* dmg, ProjectileManagerComponent* proj, TransformComponent* cameraTransform, float patrolTime, AIAgentPatrolDirection patrolStartDir, float idleTime, TransformComponent* targetTransform, float viewRange, float shotInterval);
 	
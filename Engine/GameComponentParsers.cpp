@@ -0,0 +1,261 @@
+#include "GameComponentParsers.h"
+
+#include "GameComponentFactory.h"
+#include "ObjectManager.h"
+#include "PrefabArchetype.h"
+
+namespace
+{
+	struct PlayerArgs
+	{
+		int transformComponentID = -1, animatorComponentID = -1, rigidBodyComponentID = -1, damageableComponentID = -1, projectileManagerComponentID = -1;
+	};
+
+	struct DamageableArgs
+	{
+		float startHealth = 0;
+		string hitNoise;
+	};
+
+	struct ProjectileArgs
+	{
+		string affectedTag;
+		float lifeSpan = 0, damage = 0;
+	};
+
+	struct AIAgentArgs
+	{
+		int transformComponentID = -1, animatorComponentID = -1, rigidBodyComponentID = -1, damageableComponentID = -1, projectileManagerComponentID = -1;
+		float patrolTime = 0;
+		string startDirection;
+		float idleTime = 0;
+		int targetTransformComponentID = -1;
+		float viewRange = 0, shotInterval = 0;
+	};
+
+	struct ProjectileManagerArgs
+	{
+		int projectileCount = 0;
+		string projectHitTag;
+		int parentGameObjectID = -1;
+		string poolType = "Ball";
+		int quota = 0;
+	};
+
+	struct GameCameraArgs
+	{
+		int focusTransformID = -1;
+		float leftBound = 0, rightBound = 0, bottomBound = 0, topBound = 0, focusHeight = 0, focusWidth = 0;
+	};
+
+	struct GUITextValueArgs
+	{
+		string text, valueName;
+		int transformComponentID = -1;
+		float r = 0, g = 0, b = 0, xOffset = 0, yOffset = 0;
+		int renderLayer = 0;
+	};
+
+	struct GUITextDamageArgs
+	{
+		string text;
+		int transformComponentID = -1, damageComponentID = -1;
+		float r = 0, g = 0, b = 0, xOffset = 0, yOffset = 0;
+		int renderLayer = 0;
+	};
+
+	struct GameManagerArgs
+	{
+		int buttonID = -1, textID = -1, spriteID = -1, triggerBoxID = -1, damageID = -1;
+	};
+
+	// The ball the game has always fired, for scenes that don't define their own. Compiled the first time a pool needs it
+	shared_ptr<PrefabArchetype> DefaultProjectilePrefab()
+	{
+		static shared_ptr<PrefabArchetype> prefab = PrefabArchetype::FromXml(
+			"<Prefab name=\"Ball\" tag=\"Ball\">"
+			"<Component type=\"TransformComponent\" xpos=\"0\" ypos=\"0\" rotation=\"0\" scale=\"0.2\"/>"
+			"<Component type=\"RigidBodyComponent\" staticfriction=\"1\" dynamicfriction=\"0.3\" restitution=\"0.5\" static=\"false\" lockrotation=\"false\" continuous=\"true\"/>"
+			"<Component type=\"CircleColliderComponent\" radius=\"64\" transformcomponentid=\"-1\" rigidbodycomponentid=\"-1\" layer=\"Projectile\"/>"
+			"<Component type=\"SpriteRendererComponent\" filename=\"Ball\" transformcomponentid=\"-1\" width=\"128\" height=\"128\" xoffset=\"0\" yoffset=\"0\" renderLayer=\"1\"/>"
+			"<Component type=\"ProjectileComponent\" affectedTag=\"\" lifespan=\"10\" damage=\"10\"/>"
+			"</Prefab>");
+
+		return prefab;
+	}
+}
+
+void ComponentParsers::RegisterGameParsers(ComponentParserRegistry & registry)
+{
+	registry.Register<PlayerArgs>("PlayerComponent", {
+		{ "transformcomponentid", &PlayerArgs::transformComponentID },
+		{ "animatorcomponentid", &PlayerArgs::animatorComponentID },
+		{ "rigidbodycomponentid", &PlayerArgs::rigidBodyComponentID },
+		{ "damageablecomponentid", &PlayerArgs::damageableComponentID },
+		{ "projectilemangercomponentid", &PlayerArgs::projectileManagerComponentID } },
+		[](const ComponentParseContext& context, const PlayerArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		SpriteAnimatorComponent* anim = context.FindComponent<SpriteAnimatorComponent>(args.animatorComponentID);
+		RigidBodyComponent* rb = context.FindComponent<RigidBodyComponent>(args.rigidBodyComponentID);
+		DamageableComponent* dmg = context.FindComponent<DamageableComponent>(args.damageableComponentID);
+		ProjectileManagerComponent* projectileManager = context.FindComponent<ProjectileManagerComponent>(args.projectileManagerComponentID);
+
+		return ComponentFactory::MakePlayerComponent(trans, anim, rb, dmg, projectileManager, context.camera->GetComponent<TransformComponent>());
+	});
+
+	registry.Register<DamageableArgs>("DamageableComponent", {
+		{ "starthealth", &DamageableArgs::startHealth },
+		{ "hitnoise", &DamageableArgs::hitNoise } },
+		[](const ComponentParseContext& context, const DamageableArgs& args)
+	{
+		return ComponentFactory::MakeDamageableComponent(args.startHealth, args.hitNoise);
+	});
+
+	registry.Register<ProjectileArgs>("ProjectileComponent", {
+		{ "affectedTag", &ProjectileArgs::affectedTag },
+		{ "lifespan", &ProjectileArgs::lifeSpan },
+		{ "damage", &ProjectileArgs::damage } },
+		[](const ComponentParseContext& context, const ProjectileArgs& args)
+	{
+		return ComponentFactory::MakeProjectileComponent(args.affectedTag, args.lifeSpan, args.damage);
+	});
+
+	registry.Register<AIAgentArgs>("AIAgentComponent", {
+		{ "transformcomponentid", &AIAgentArgs::transformComponentID },
+		{ "animatorcomponentid", &AIAgentArgs::animatorComponentID },
+		{ "rigidbodycomponentid", &AIAgentArgs::rigidBodyComponentID },
+		{ "damageablecomponentid", &AIAgentArgs::damageableComponentID },
+		{ "projectilemangercomponentid", &AIAgentArgs::projectileManagerComponentID },
+		{ "patrolTime", &AIAgentArgs::patrolTime },
+		{ "startdirection", &AIAgentArgs::startDirection },
+		{ "idletime", &AIAgentArgs::idleTime },
+		{ "targettransformcomponentid", &AIAgentArgs::targetTransformComponentID },
+		{ "viewrange", &AIAgentArgs::viewRange },
+		{ "shotintervals", &AIAgentArgs::shotInterval } },
+		[](const ComponentParseContext& context, const AIAgentArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		SpriteAnimatorComponent* anim = context.FindComponent<SpriteAnimatorComponent>(args.animatorComponentID);
+		RigidBodyComponent* rb = context.FindComponent<RigidBodyComponent>(args.rigidBodyComponentID);
+		DamageableComponent* dmg = context.FindComponent<DamageableComponent>(args.damageableComponentID);
+		ProjectileManagerComponent* projectileManager = context.FindComponent<ProjectileManagerComponent>(args.projectileManagerComponentID);
+		TransformComponent* targetTrans = context.FindComponent<TransformComponent>(args.targetTransformComponentID);
+
+		AIAgentPatrolDirection dir;
+		if (args.startDirection == "right")
+			dir = AIAgentPatrolDirection::ePatrollingRight;
+		else
+			dir = AIAgentPatrolDirection::ePatrollingLeft;
+
+		return ComponentFactory::MakeAIAgentComponent(trans, anim, rb, dmg, projectileManager, context.camera->GetComponent<TransformComponent>(),
+			args.patrolTime, dir, args.idleTime, targetTrans, args.viewRange, args.shotInterval);
+	});
+
+	registry.Register<ProjectileManagerArgs>("ProjectileManagerComponent", {
+		{ "projectilecount", &ProjectileManagerArgs::projectileCount },
+		{ "projecthittag", &ProjectileManagerArgs::projectHitTag },
+		{ "parentgameobjectid", &ProjectileManagerArgs::parentGameObjectID },
+		{ "pooltype", &ProjectileManagerArgs::poolType, eAttributeOptional },
+		{ "quota", &ProjectileManagerArgs::quota, eAttributeOptional } },
+		[](const ComponentParseContext& context, const ProjectileManagerArgs& args)
+	{
+		if (context.objects == nullptr)
+			throw std::exception("A ProjectileManagerComponent can only be built as part of a scene.");
+
+		// Managers with the same pool type share one pool, big enough for all of them
+		shared_ptr<ObjectPool>& pool = context.objects->GetPool(args.poolType);
+		if (pool == nullptr)
+		{
+			// A scene can describe its own projectile as a prefab with the pool type's name
+			shared_ptr<PrefabArchetype> prefab = context.objects->GetPrefab(args.poolType);
+			if (prefab == nullptr)
+				prefab = DefaultProjectilePrefab();
+
+			prefab = prefab->WithTag(args.poolType)->Override("ProjectileComponent", "affectedTag", args.projectHitTag);
+
+			// Also called to grow the pool once the scene is running, so it can't refer to anything that only lives while loading
+			GameObject* parentObject = context.objects->GetCreatedObject(args.parentGameObjectID).get();
+			EntityHandle parent = parentObject != nullptr ? parentObject->GetHandle() : EntityHandle();
+			pool = make_shared<ObjectPool>(args.poolType, [prefab, parent](int count, vector<shared_ptr<GameObject>>& gameObjects)
+			{
+				int first = (int)gameObjects.size();
+				prefab->Instantiate(count, std::rand(), gameObjects);
+
+				GameObject* parentObject = EntityTable::Instance().Resolve(parent);
+				for (int i = first; i < gameObjects.size(); i++)
+					gameObjects[i]->SetParent(parentObject);
+			});
+		}
+
+		pool->Reserve(pool->GetStats().capacity + args.projectileCount);
+
+		return ComponentFactory::MakeProjectileManagerComponent(pool, args.quota);
+	});
+
+	registry.Register<GameCameraArgs>("GameCameraComponent", {
+		{ "focusTransID", &GameCameraArgs::focusTransformID },
+		{ "leftBound", &GameCameraArgs::leftBound },
+		{ "rightBound", &GameCameraArgs::rightBound },
+		{ "bottomBound", &GameCameraArgs::bottomBound },
+		{ "topBound", &GameCameraArgs::topBound },
+		{ "focusHeight", &GameCameraArgs::focusHeight },
+		{ "focusWidth", &GameCameraArgs::focusWidth } },
+		[](const ComponentParseContext& context, const GameCameraArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.focusTransformID);
+
+		return ComponentFactory::MakeGameCameraComponent(context.camera->GetComponent<TransformComponent>(), trans,
+			args.focusWidth, args.focusHeight, args.leftBound, args.rightBound, args.topBound, args.bottomBound);
+	});
+
+	registry.Register<GUITextValueArgs>("GUITextValueComponent", {
+		{ "text", &GUITextValueArgs::text },
+		{ "valueName", &GUITextValueArgs::valueName },
+		{ "transformcomponentid", &GUITextValueArgs::transformComponentID },
+		{ "r", &GUITextValueArgs::r },
+		{ "g", &GUITextValueArgs::g },
+		{ "b", &GUITextValueArgs::b },
+		{ "xoffset", &GUITextValueArgs::xOffset },
+		{ "yoffset", &GUITextValueArgs::yOffset },
+		{ "renderLayer", &GUITextValueArgs::renderLayer } },
+		[](const ComponentParseContext& context, const GUITextValueArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		return ComponentFactory::MakeGUITextValueComponent(args.valueName, args.renderLayer, args.text, args.r, args.g, args.b, trans, Vec2(args.xOffset, args.yOffset));
+	});
+
+	registry.Register<GUITextDamageArgs>("GUITextDamageComponent", {
+		{ "text", &GUITextDamageArgs::text },
+		{ "transformcomponentid", &GUITextDamageArgs::transformComponentID },
+		{ "damagecomponentid", &GUITextDamageArgs::damageComponentID },
+		{ "r", &GUITextDamageArgs::r },
+		{ "g", &GUITextDamageArgs::g },
+		{ "b", &GUITextDamageArgs::b },
+		{ "xoffset", &GUITextDamageArgs::xOffset },
+		{ "yoffset", &GUITextDamageArgs::yOffset },
+		{ "renderLayer", &GUITextDamageArgs::renderLayer } },
+		[](const ComponentParseContext& context, const GUITextDamageArgs& args)
+	{
+		TransformComponent* trans = context.FindComponent<TransformComponent>(args.transformComponentID);
+		DamageableComponent* dmg = context.FindComponent<DamageableComponent>(args.damageComponentID);
+		return ComponentFactory::MakeGUITextDamageComponent(dmg, args.renderLayer, args.text, args.r, args.g, args.b, trans, Vec2(args.xOffset, args.yOffset));
+	});
+
+	registry.Register<GameManagerArgs>("GameManagerComponent", {
+		{ "guibuttonid", &GameManagerArgs::buttonID },
+		{ "guitextid", &GameManagerArgs::textID },
+		{ "guispriteid", &GameManagerArgs::spriteID },
+		{ "triggerboxid", &GameManagerArgs::triggerBoxID },
+		{ "damageid", &GameManagerArgs::damageID } },
+		[](const ComponentParseContext& context, const GameManagerArgs& args)
+	{
+		GUIButtonComponent* button = context.FindComponent<GUIButtonComponent>(args.buttonID);
+		GUITextComponent* text = context.FindComponent<GUITextComponent>(args.textID);
+		GUISpriteRendererComponent* sprite = context.FindComponent<GUISpriteRendererComponent>(args.spriteID);
+		TriggerBoxComponent* triggerbox = context.FindComponent<TriggerBoxComponent>(args.triggerBoxID);
+		DamageableComponent* damage = context.FindComponent<DamageableComponent>(args.damageID);
+
+		return ComponentFactory::MakeGameManagerComponent(button, text, sprite, triggerbox, damage);
+	});
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "ComponentParsers.h"
+
+namespace ComponentParsers
+{
+	void RegisterGameParsers(ComponentParserRegistry& registry); // Call once at startup, before any scene is built
+}
@@ -24,6 +24,7 @@ public:
 	~GameManagerComponent();
 
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderGUI; }
 
 private:
 	GUIButtonComponent*			mCentreButton;
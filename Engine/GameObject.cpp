@@ -1,14 +1,19 @@
 #include "GameObject.h"
+#include "CommandBuffer.h"
 
 GameObject::GameObject(string tag, int id)
 {
 	mTag = tag;
+	mTagID = TagTable::Instance().Intern(tag);
 	mID = id;
-	mParent = nullptr;
+	mActive = true;
+	mHandle = EntityTable::Instance().Create(this);
 }
 
 GameObject::~GameObject()
 {
+	EntityTable::Instance().Destroy(mHandle);
+
 	for (auto component : mComponents)
 	{
 		delete component;
@@ -20,10 +25,69 @@ void GameObject::AddComponent(IComponent * component)
 {
 	if (component != nullptr)
 	{
+		if (mComponents.size() == MAX_COMPONENTS_PER_GAMEOBJECT)
+		{
+			throw std::exception("This object has too many components.");
+		}
+
 		mComponents.push_back(component);
+		CacheComponent(component);
 	}
 }
 
+void GameObject::RemoveComponent(IComponent * component)
+{
+	auto it = std::find(mComponents.begin(), mComponents.end(), component);
+	if (it == mComponents.end())
+		return;
+
+	UncacheComponent(component);
+	mComponents.erase(it);
+	delete component;
+}
+
+void GameObject::CacheComponent(IComponent * component)
+{
+	component->mCapabilities = 0;
+
+	IUpdateable * updateableComponent = dynamic_cast<IUpdateable *> (component);
+	if (updateableComponent != nullptr)
+	{
+		component->mCapabilities |= eUpdateable;
+		mUpdateables.push_back({ component, updateableComponent });
+	}
+
+	IDrawable * drawableComponent = dynamic_cast<IDrawable *> (component);
+	if (drawableComponent != nullptr)
+	{
+		component->mCapabilities |= eDrawable;
+		mDrawables.push_back({ component, drawableComponent });
+	}
+
+	IMessageable * messageableComponent = dynamic_cast<IMessageable *> (component);
+	if (messageableComponent != nullptr)
+	{
+		component->mCapabilities |= eMessageable;
+		mMessageables.push_back({ component, messageableComponent });
+	}
+
+	// The new component could match any type that has already been looked up
+	mTypeMasks.clear();
+}
+
+void GameObject::UncacheComponent(IComponent * component)
+{
+	mUpdateables.erase(std::remove_if(mUpdateables.begin(), mUpdateables.end(),
+		[component](const ComponentCapabilityEntry<IUpdateable>& entry) { return entry.component == component; }), mUpdateables.end());
+	mDrawables.erase(std::remove_if(mDrawables.begin(), mDrawables.end(),
+		[component](const ComponentCapabilityEntry<IDrawable>& entry) { return entry.component == component; }), mDrawables.end());
+	mMessageables.erase(std::remove_if(mMessageables.begin(), mMessageables.end(),
+		[component](const ComponentCapabilityEntry<IMessageable>& entry) { return entry.component == component; }), mMessageables.end());
+
+	// Component indices after this one are about to shift
+	mTypeMasks.clear();
+}
+
 void GameObject::SetActive(bool active)
 {
 	mActive = active;
@@ -33,40 +97,44 @@ void GameObject::SetActive(bool active)
 	}
 }
 
-void GameObject::SetParent(shared_ptr<GameObject> parent)
+void GameObject::QueueSetActive(bool active)
+{
+	if (mCommandBuffer != nullptr)
+		mCommandBuffer->SetActive(mHandle, active);
+	else
+		SetActive(active);
+}
+
+void GameObject::SetParent(GameObject* parent)
 {
-	if (mParent != nullptr)
+	GameObject* previousParent = GetParent();
+	if (previousParent != nullptr)
 	{
 		// Remove THIS GAMEOBJECT as a child from the previous parent
-		mParent->RemoveChild(shared_ptr<GameObject>(this));
+		previousParent->RemoveChild(mHandle);
 	}
 
-	mParent = parent; // Set the new parent for THIS GAMEOBJECT
+	mParent = parent != nullptr ? parent->GetHandle() : EntityHandle(); // Set the new parent for THIS GAMEOBJECT
 
 	// Set the parent transform in THIS GAMEOBJECT'S transform
-	for (auto component : mComponents)
+	TransformComponent * transformComponent = GetComponent<TransformComponent>();
+	if (transformComponent != nullptr)
 	{
-		// Cast component to TransformComponent
-		TransformComponent * transformComponent = dynamic_cast<TransformComponent *> (component);
-		if (transformComponent != nullptr)
-		{
-			transformComponent->SetParent(mParent->GetComponent<TransformComponent>());
-			break;
-		}
+		transformComponent->SetParent(parent != nullptr ? parent->GetComponent<TransformComponent>() : nullptr);
 	}
 
-	if (mParent != nullptr)
+	if (parent != nullptr)
 	{
-		mParent->AddChild(shared_ptr<GameObject>(this)); // Set THIS GAMEOBJECT as a child for the new parent
+		parent->AddChild(mHandle); // Set THIS GAMEOBJECT as a child for the new parent
 	}
 }
 
-void GameObject::AddChild(shared_ptr<GameObject> child)
+void GameObject::AddChild(EntityHandle child)
 {
 	mChildren.push_back(child);
 }
 
-void GameObject::RemoveChild(shared_ptr<GameObject> child)
+void GameObject::RemoveChild(EntityHandle child)
 {
 	// Remove a child from THIS GAMEOBJECTS vector of children
 	auto it = std::find(mChildren.begin(), mChildren.end(), child);
@@ -76,42 +144,29 @@ void GameObject::RemoveChild(shared_ptr<GameObject> child)
 
 shared_ptr<GameObject> GameObject::MakeGameObject(string tag, int ID)
 {
-	auto gameObject = make_shared<GameObject>(tag, ID);
+	// Allocated along with its reference count, in the current scene's arena if there is one
+	auto gameObject = allocate_shared<GameObject>(SceneArenaAllocator<GameObject>(), tag, ID);
 	return gameObject;
 }
 
 void GameObject::SendMessageToComponents(IMessage & message)
 {
-	for (auto component : mComponents)
+	for (auto& entry : mMessageables)
 	{
-		if (component->GetActive())
+		if (entry.component->GetActive())
 		{
-			// Cast component to IMessageable
-			IMessageable * messageableComponent = dynamic_cast<IMessageable *> (component);
-
-			if (messageableComponent != nullptr)
-			{
-				// Is messageable
-				messageableComponent->RecieveMessage(message);
-			}
+			entry.capability->RecieveMessage(message);
 		}
 	}
 }
 
 void GameObject::Draw(ICamera* cam) const
 {
-	for (auto component : mComponents)
+	for (auto& entry : mDrawables)
 	{
-		if (component->GetActive())
+		if (entry.component->GetActive())
 		{
-			// Cast component to IDrawable
-			IDrawable * drawableComponent = dynamic_cast<IDrawable *> (component);
-
-			if (drawableComponent != nullptr)
-			{
-				// Is drawable
-				drawableComponent->Draw(cam);
-			}
+			entry.capability->Draw(cam);
 		}
 	}
 }
@@ -119,18 +174,11 @@ void GameObject::Draw(ICamera* cam) const
 void GameObject::Update(float deltaTime)
 {
 	// Update all updateable components
-	for (auto component : mComponents)
+	for (auto& entry : mUpdateables)
 	{
-		if (component->GetActive())
+		if (entry.component->GetActive())
 		{
-			// Cast component to IUpdateable - This is bad!!
-			IUpdateable * updateableComponent = dynamic_cast<IUpdateable *> (component);
-
-			if (updateableComponent != nullptr)
-			{
-				// Is updateable
-				updateableComponent->Update(deltaTime);
-			}
+			entry.capability->Update(deltaTime);
 		}
 	}
 }
\ No newline at end of file
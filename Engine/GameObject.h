@@ -8,45 +8,74 @@
 #include "IMessageable.h"
 
 #include "ICamera.h"
+#include "SceneArena.h"
+#include "EntityTable.h"
+#include "TagTable.h"
 
 using namespace std;
 
+class MessageBus;
+class CommandBuffer;
+
+// A component along with the interface it was found to implement, so it never needs casting again
+template<class T>
+struct ComponentCapabilityEntry
+{
+	IComponent*			component;
+	T*					capability;
+};
+
 class GameObject
 {
+	friend class MessageBus;
+	friend class CommandBuffer;
+
 public:
 	GameObject(string tag, int id);
 	~GameObject();
 
+	// GameObjects built while a scene is loading live in that scene's arena
+	static void* operator new(size_t size) { return SceneArena::AllocateObject(size); }
+	static void operator delete(void* memory) { SceneArena::FreeObject(memory); }
+
 	void Draw(ICamera* cam) const;
 	virtual void Update(float deltaTime);
 
 	void SendMessageToComponents(IMessage& message);
+	template<class T>
+	void QueueMessage(const T& message); // Delivered at the scene's next sync point, or straight away if the object isn't in a scene. Defined in MessageBus.h
 	void AddComponent(IComponent* component);
+	void RemoveComponent(IComponent* component); // Deletes the component
 
-	string GetTag() { return mTag; }
+	const string& GetTag() const { return mTag; }
+	TagID GetTagID() const { return mTagID; } // Compare these rather than the tag strings
 	int GetID() { return mID; }
+	EntityHandle GetHandle() const { return mHandle; }
 	vector<IComponent*> GetAllComponents() { return mComponents; }
+	const vector<ComponentCapabilityEntry<IUpdateable>>& GetUpdateableComponents() { return mUpdateables; }
 
 	void SetActive(bool active);
 	bool GetActive() { return mActive; }
+	void QueueSetActive(bool active); // Applied at the scene's next sync point, or straight away if the object isn't in a scene
 
-	void SetParent(shared_ptr<GameObject> parent);
-	shared_ptr<GameObject> GetParent() { return mParent; }
+	CommandBuffer* GetCommandBuffer() { return mCommandBuffer; } // Records structural changes until the scene's next sync point. Null if the object isn't in a scene
 
-	void AddChild(shared_ptr<GameObject> child);
-	void RemoveChild(shared_ptr<GameObject> child);
-	vector<shared_ptr<GameObject>> GetChildren() { return mChildren; }
+	void SetParent(GameObject* parent); // Null to unparent
+	GameObject* GetParent() const { return EntityTable::Instance().Resolve(mParent); }
+
+	void AddChild(EntityHandle child);
+	void RemoveChild(EntityHandle child);
+	const vector<EntityHandle>& GetChildren() const { return mChildren; } // Resolve through EntityTable. A child destroyed without unparenting resolves to null
 
 	template<class T>
 	T * GetComponent()
 	{
-		for (auto component : mComponents)
+		ComponentMask matches = FindComponents<T>();
+		for (int i = 0; matches != 0; i++, matches >>= 1)
 		{
-			T* tComponent = dynamic_cast<T *> (component);
-
-			if (tComponent != nullptr)
+			if (matches & 1)
 			{
-				return tComponent;
+				return CastComponent<T>(mComponents[i]);
 			}
 		}
 
@@ -57,13 +86,13 @@ public:
 	vector<T*> GetComponents()
 	{
 		vector<T*> components;
-		for (auto component : mComponents)
-		{
-			T* tComponent = dynamic_cast<T *> (component);
 
-			if (tComponent != nullptr)
+		ComponentMask matches = FindComponents<T>();
+		for (int i = 0; matches != 0; i++, matches >>= 1)
+		{
+			if (matches & 1)
 			{
-				components.push_back(tComponent);
+				components.push_back(CastComponent<T>(mComponents[i]));
 			}
 		}
 
@@ -73,14 +102,12 @@ public:
 	template<class T>
 	void RemoveComponent()
 	{
-		for (int i = 0; i < mComponents.size(); i++)
+		ComponentMask matches = FindComponents<T>();
+		for (int i = 0; matches != 0; i++, matches >>= 1)
 		{
-			T* tComponent = dynamic_cast<T *> (mComponents[i]);
-
-			if (tComponent != nullptr)
+			if (matches & 1)
 			{
-				mComponents.erase(mComponents.begin() + i);
-				delete tComponent;
+				RemoveComponent(mComponents[i]);
 				return;
 			}
 		}
@@ -89,10 +116,60 @@ public:
 	static shared_ptr<GameObject> MakeGameObject(string tag, int ID);
 
 protected:
+	void CacheComponent(IComponent* component); // Works out what the component can do and adds it to the matching lists
+	void UncacheComponent(IComponent* component);
+
+	// Bit i is set if mComponents[i] is a T. Each type is only worked out with dynamic_cast the first time it is looked up
+	template<class T>
+	ComponentMask FindComponents()
+	{
+		int typeID = GetComponentTypeID<T>();
+		if (typeID >= (int)mTypeMasks.size())
+		{
+			mTypeMasks.resize(typeID + 1, COMPONENT_MASK_UNKNOWN);
+		}
+
+		if (mTypeMasks[typeID] == COMPONENT_MASK_UNKNOWN)
+		{
+			ComponentMask matches = 0;
+			for (int i = 0; i < mComponents.size(); i++)
+			{
+				if (dynamic_cast<T *> (mComponents[i]) != nullptr)
+				{
+					matches |= ComponentMask(1) << i;
+				}
+			}
+
+			mTypeMasks[typeID] = matches;
+		}
+
+		return mTypeMasks[typeID];
+	}
+
+	// Only called on components already known to be a T
+	template<class T>
+	static T * CastComponent(IComponent* component) { return CastComponent<T>(component, is_base_of<IComponent, T>()); }
+	template<class T>
+	static T * CastComponent(IComponent* component, true_type) { return static_cast<T *> (component); }
+	template<class T>
+	static T * CastComponent(IComponent* component, false_type) { return dynamic_cast<T *> (component); } // Interfaces aren't related to IComponent so still need a cross cast
+
 	vector<IComponent*>				mComponents;
+	vector<ComponentMask>			mTypeMasks; // Indexed by component type ID. Cleared whenever the components change
+
+	vector<ComponentCapabilityEntry<IUpdateable>>	mUpdateables;
+	vector<ComponentCapabilityEntry<IDrawable>>		mDrawables;
+	vector<ComponentCapabilityEntry<IMessageable>>	mMessageables;
+
+	MessageBus*						mMessageBus = nullptr;
+	int								mMessageSlot = -1; // Index of this object's receivers in mMessageBus
+	CommandBuffer*					mCommandBuffer = nullptr;
+
 	string							mTag;
+	TagID							mTagID;
 	int								mID;
-	shared_ptr<GameObject>			mParent;
-	vector<shared_ptr<GameObject>>	mChildren;
+	EntityHandle					mHandle;
+	EntityHandle					mParent;
+	vector<EntityHandle>			mChildren;
 	bool							mActive;
 };
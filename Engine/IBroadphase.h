@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "Consts.h"
+
+struct BroadphasePair
+{
+	int elementA; // Always the lower of the two element indices so a pair is only ever stored one way round
+	int elementB;
+
+	BroadphasePair(int a, int b) : elementA(std::min(a, b)), elementB(std::max(a, b)) { }
+
+	bool operator<(const BroadphasePair& other) const
+	{
+		return elementA < other.elementA || (elementA == other.elementA && elementB < other.elementB);
+	}
+
+	bool operator==(const BroadphasePair& other) const
+	{
+		return elementA == other.elementA && elementB == other.elementB;
+	}
+};
+
+class IBroadphase
+{
+public:
+	virtual ~IBroadphase() { }
+
+	virtual int CreateProxy(const AABB& aabb, int element) = 0; // Adds an element with the specified bounds. Returns the proxy ID used to refer to it from then on
+	virtual void DestroyProxy(int proxyID) = 0; // Removes a proxy from the broadphase
+	virtual bool MoveProxy(int proxyID, const AABB& aabb) = 0; // Updates the bounds of a proxy. Returns true if the broadphase had to restructure to fit it
+
+	virtual void Query(const AABB& aabb, std::vector<int>& elements) const = 0; // Appends every element whose bounds overlap 'aabb'
+	virtual const AABB& GetFatAABB(int proxyID) const = 0; // Gets the enlarged bounds the broadphase has stored for a proxy
+};
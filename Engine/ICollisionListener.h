@@ -0,0 +1,12 @@
+#pragma once
+
+#include "CollisionEvent.h"
+
+class CollisionEventQueue;
+
+class ICollisionListener
+{
+public:
+	virtual void SubscribeToCollisions(CollisionEventQueue& events, ColliderComponent* collider) = 0; // Called when the object is added to a scene. 'collider' is the object's own collider, if it has one
+	virtual void RecieveCollisionEvent(const CollisionEvent& event) = 0;
+};
@@ -2,17 +2,53 @@
 
 #include <string>
 
+#include "ComponentTypeID.h"
+#include "SceneArena.h"
+
 using namespace std;
 
+class IComponent;
+
+class IActivationListener
+{
+public:
+	virtual void ComponentActiveChanged(IComponent* component) = 0;
+};
+
 class IComponent
 {
+	friend class GameObject;
+
 public:
+	// Components built while a scene is loading live in that scene's arena
+	static void* operator new(size_t size) { return SceneArena::AllocateObject(size); }
+	static void operator delete(void* memory) { SceneArena::FreeObject(memory); }
+
+	virtual ~IComponent() { }
+
 	virtual string GetType() { return mType; }
 
-	void SetActive(bool active) { mActive = active; }
+	void SetActive(bool active)
+	{
+		if (active == mActive)
+			return;
+
+		mActive = active;
+
+		if (mActivationListener != nullptr)
+			mActivationListener->ComponentActiveChanged(this);
+	}
 	bool GetActive() { return mActive; }
 
+	void SetActivationListener(IActivationListener* listener) { mActivationListener = listener; } // Told whenever the component is activated or deactivated. Only one at a time
+
+	bool HasCapability(ComponentCapability capability) { return (mCapabilities & capability) != 0; } // Only set once the component has been added to a GameObject
+
 protected:
 	string			mType;
 	bool			mActive = true;
+
+private:
+	int							mCapabilities = 0;
+	IActivationListener*		mActivationListener = nullptr;
 };
\ No newline at end of file
@@ -2,8 +2,12 @@
 
 #include "IMessage.h"
 
+class MessageBus;
+class GameObject;
+
 class IMessageable
 {
 public:
 	virtual void RecieveMessage(IMessage & message) = 0;
+	virtual void SubscribeToMessages(MessageBus& bus, GameObject* owner) { } // Called when the owner is added to a scene. Subscribe to the message types handled here
 };
\ No newline at end of file
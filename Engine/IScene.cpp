@@ -2,7 +2,7 @@
 
 void IScene::Draw()
 {
-	map<int, vector<shared_ptr<GameObject>>>::iterator renderLayer;
+	map<int, vector<GameObject*>>::iterator renderLayer;
 
 	for (renderLayer = mRenderLayers.begin(); renderLayer != mRenderLayers.end(); renderLayer++)
 	{
@@ -12,3 +12,35 @@ void IScene::Draw()
 		}
 	}
 }
+
+
+bool IScene::AddPool(shared_ptr<ObjectPool> pool)
+{
+	if (std::find(mPools.begin(), mPools.end(), pool) != mPools.end())
+		return false;
+
+	mPools.push_back(pool);
+	return true;
+}
+
+void IScene::CacheComponent(GameObject * gameObj, IComponent * component)
+{
+	IDrawable * drawableComponent = dynamic_cast<IDrawable *> (component);
+	if (drawableComponent != nullptr)
+	{
+		mRenderLayers[drawableComponent->RenderLayer].push_back(gameObj);
+	}
+}
+
+void IScene::UncacheComponent(GameObject * gameObj, IComponent * component)
+{
+	IDrawable * drawableComponent = dynamic_cast<IDrawable *> (component);
+	if (drawableComponent != nullptr)
+	{
+		// The object is in the layer once for every drawable component it has, so only take one of them out
+		auto& renderLayer = mRenderLayers[drawableComponent->RenderLayer];
+		auto it = std::find(renderLayer.begin(), renderLayer.end(), gameObj);
+		if (it != renderLayer.end())
+			renderLayer.erase(it);
+	}
+}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "GameObject.h"
+#include "ObjectPool.h"
 #include "ICameraGameObject.h"
+#include "SceneArena.h"
+#include "RigidBodyWorld.h"
 
 using namespace std;
 
@@ -14,16 +17,28 @@ public:
 
 	virtual void Update(float deltaTime) = 0;
 	virtual void CacheComponents(shared_ptr<GameObject> gameObj) = 0;
+	virtual void CacheComponent(GameObject* gameObj, IComponent* component); // Adds a component given to an object already in the scene
+	virtual void UncacheComponent(GameObject* gameObj, IComponent* component); // Called before a component is removed from an object in the scene
 
 	ICameraGameObject* GetCamera() { return mCamera; }
+	SceneArena& GetArena() { return mArena; } // Owns the memory of everything SceneBuilder builds for this scene
+	RigidBodyWorld& GetUnassignedBodies() { return mUnassignedBodies; } // Bodies built for this scene that aren't being simulated
 	int GetNumberOfGameObjects() { return (int)mGameObjects.size(); }
 	shared_ptr<GameObject> GetGameObjectAtIndex(int index) { return mGameObjects.at(index); }
+	const vector<shared_ptr<ObjectPool>>& GetPools() const { return mPools; }
 
 	LevelData											SceneData;
 
 protected:
-	map<int, vector<shared_ptr<GameObject>>>			mRenderLayers;
+	bool AddPool(shared_ptr<ObjectPool> pool); // False if the pool is already in the scene
+
+	// Declared first so it is released after every object in it has been destroyed
+	SceneArena											mArena;
+	RigidBodyWorld										mUnassignedBodies; // Also outlives the objects, whose bodies remove themselves from it
+
+	map<int, vector<GameObject*>>						mRenderLayers; // Owned by mGameObjects
 	vector<shared_ptr<GameObject>>						mGameObjects;
+	vector<shared_ptr<ObjectPool>>						mPools; // Can be shared by several objects, so kept to only add each one once
 
 	ICameraGameObject*									mCamera;
 };
\ No newline at end of file
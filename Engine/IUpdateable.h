@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Consts.h"
+
 class IUpdateable
 {
 public:
 	virtual void Update(float deltaTime) = 0;
+	virtual UpdateOrder GetUpdateOrder() { return eUpdateOrderDefault; }
+	virtual UpdateThreading GetUpdateThreading() { return eUpdateSerial; } // Parallel types ignore UpdateOrder
 };
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "JobSystem.h"
+
+// Queue of the thread in its JobSystem. Every thread that isn't a worker shares queue 0
+static thread_local int tQueueIndex = 0;
+
+JobID JobGraph::AddJob(const char * name, std::function<void()> work)
+{
+	mJobs.emplace_back();
+
+	Job& job = mJobs.back();
+	job.work = work;
+	job.name = name;
+	job.counter = &mCounter;
+	job.graph = this;
+	job.index = (int)mJobs.size() - 1;
+
+	return job.index;
+}
+
+void JobGraph::AddDependency(JobID job, JobID dependsOn)
+{
+	if (job < 0 || job >= mJobs.size() || dependsOn < 0 || dependsOn >= job)
+		throw std::exception("Jobs can only depend on jobs that were added before them.");
+
+	mJobs[dependsOn].dependents.push_back(&mJobs[job]);
+	mJobs[job].dependencyCount++;
+}
+
+JobSystem::JobSystem(int workerCount) : mQueuedJobs(0)
+{
+	for (int i = 0; i < workerCount + 1; i++)
+		mQueues.emplace_back(new WorkQueue());
+
+	for (int i = 0; i < workerCount; i++)
+		mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+		mShutdown = true;
+	}
+
+	mWorkAvailable.notify_all();
+
+	for (auto& worker : mWorkers)
+		worker.join();
+}
+
+void JobSystem::Run(JobGraph & graph)
+{
+	if (graph.mJobs.empty())
+		return;
+
+	graph.mTimings.resize(graph.mJobs.size());
+	graph.mStartTime = std::chrono::high_resolution_clock::now();
+	graph.mCounter.remaining = (int)graph.mJobs.size();
+	graph.mCounter.failed = false;
+	graph.mCounter.error = nullptr;
+
+	// Every counter has to be reset before anything starts, as a job can finish and release its dependents straight away
+	for (auto& job : graph.mJobs)
+		job.dependenciesLeft = job.dependencyCount;
+
+	for (auto& job : graph.mJobs)
+	{
+		if (job.dependencyCount == 0)
+			Push(&job);
+	}
+
+	WaitFor(graph.mCounter);
+}
+
+void JobSystem::ParallelFor(int count, int grainSize, const std::function<void(int begin, int end)>& task)
+{
+	if (count <= 0)
+		return;
+
+	// A few ranges per thread so one slow range doesn't leave the other threads waiting
+	grainSize = std::max(grainSize, 1);
+	int rangeCount = std::min((count + grainSize - 1) / grainSize, GetThreadCount() * 4);
+
+	if (mWorkers.empty() || rangeCount <= 1)
+	{
+		task(0, count);
+		return;
+	}
+
+	int rangeSize = (count + rangeCount - 1) / rangeCount;
+	rangeCount = (count + rangeSize - 1) / rangeSize;
+
+	// Only referenced by the jobs until the counter reaches zero, so they can live on this stack
+	std::unique_ptr<Job[]> jobs(new Job[rangeCount]);
+	JobCounter counter;
+	counter.remaining = rangeCount;
+
+	for (int i = 0; i < rangeCount; i++)
+	{
+		int begin = i * rangeSize;
+		int end = std::min(begin + rangeSize, count);
+
+		jobs[i].work = [&task, begin, end] { task(begin, end); };
+		jobs[i].counter = &counter;
+		jobs[i].dependenciesLeft = 0;
+	}
+
+	// Pushed backwards so the ranges are stolen from the front in order. The calling thread takes the first range itself
+	for (int i = rangeCount - 1; i > 0; i--)
+		Push(&jobs[i]);
+
+	Execute(&jobs[0]);
+	WaitFor(counter);
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+	tQueueIndex = queueIndex;
+
+	while (true)
+	{
+		Job* job = FindJob();
+		if (job != nullptr)
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mSleepMutex);
+		mWorkAvailable.wait(lock, [this] { return mShutdown || mQueuedJobs > 0; });
+
+		if (mShutdown)
+			return;
+	}
+}
+
+void JobSystem::Push(Job * job)
+{
+	{
+		WorkQueue& queue = *mQueues[tQueueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+
+	// Counted before taking the sleep lock so a worker checking whether to sleep can't miss it
+	mQueuedJobs++;
+
+	{
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+	}
+
+	mWorkAvailable.notify_one();
+}
+
+Job * JobSystem::FindJob()
+{
+	// Newest job first from our own queue, as it is the most likely to still be in the cache
+	{
+		WorkQueue& queue = *mQueues[tQueueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			Job* job = queue.jobs.back();
+			queue.jobs.pop_back();
+			mQueuedJobs--;
+			return job;
+		}
+	}
+
+	// Oldest job from anyone else's, as it is the most likely to create more work
+	for (int i = 1; i < mQueues.size(); i++)
+	{
+		WorkQueue& queue = *mQueues[(tQueueIndex + i) % mQueues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			Job* job = queue.jobs.front();
+			queue.jobs.pop_front();
+			mQueuedJobs--;
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(Job * job)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	// Caught here rather than let through, as nothing would be left to count the job as finished and its waiter would spin forever
+	if (!job->counter->failed)
+	{
+		try
+		{
+			job->work();
+		}
+		catch (...)
+		{
+			if (!job->counter->failed.exchange(true))
+				job->counter->error = std::current_exception();
+		}
+	}
+
+	if (job->graph != nullptr)
+	{
+		auto end = std::chrono::high_resolution_clock::now();
+
+		JobTiming& timing = job->graph->mTimings[job->index];
+		timing.name = job->name;
+		timing.thread = tQueueIndex;
+		timing.startMs = std::chrono::duration<double, std::milli>(start - job->graph->mStartTime).count();
+		timing.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	for (Job* dependent : job->dependents)
+	{
+		if (--dependent->dependenciesLeft == 0)
+			Push(dependent);
+	}
+
+	// Last, as whoever is waiting on the counter is free to destroy the job as soon as it reaches zero
+	job->counter->remaining--;
+}
+
+void JobSystem::WaitFor(JobCounter& counter)
+{
+	while (counter.remaining > 0)
+	{
+		Job* job = FindJob();
+		if (job != nullptr)
+			Execute(job);
+		else
+			std::this_thread::yield(); // Whatever is left is running on another thread
+	}
+
+	if (counter.error)
+		std::rethrow_exception(counter.error);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+
+class JobGraph;
+
+typedef int JobID;
+
+// How long one job in a graph took the last time the graph ran
+struct JobTiming
+{
+	const char*		name;
+	int				thread; // 0 for the thread that ran the graph, or any other thread that isn't a worker
+	double			startMs; // Since the graph started running
+	double			durationMs;
+};
+
+// Jobs of one graph or parallel for that haven't finished yet, and the first exception any of them threw
+struct JobCounter
+{
+	std::atomic<int>		remaining{ 0 };
+	std::atomic<bool>		failed{ false }; // Jobs that start once this is set skip their work, so the counter still reaches zero
+	std::exception_ptr		error; // Only written by the job that set 'failed'. Rethrown on the thread waiting on the counter
+};
+
+struct Job
+{
+	std::function<void()>	work;
+	const char*				name = "";
+
+	std::vector<Job*>		dependents; // Jobs that can't start until this one has finished
+	int						dependencyCount = 0;
+	std::atomic<int>		dependenciesLeft;
+
+	JobCounter*				counter = nullptr; // Of the graph or parallel for the job belongs to. Decremented once the job has finished, even if it threw
+	JobGraph*				graph = nullptr; // Null for jobs that aren't timed
+	int						index = 0; // Position in the graph
+};
+
+// Set of jobs along with the order some of them have to run in. Built once and run as many times as needed
+class JobGraph
+{
+	friend class JobSystem;
+
+public:
+	JobID AddJob(const char* name, std::function<void()> work);
+	void AddDependency(JobID job, JobID dependsOn); // 'job' won't start until 'dependsOn' has finished. Jobs can only depend on jobs added before them, so there can't be a cycle
+
+	int GetJobCount() const { return (int)mJobs.size(); }
+	const std::vector<JobTiming>& GetTimings() const { return mTimings; } // From the last time the graph ran, in the order the jobs were added
+
+private:
+	std::deque<Job>									mJobs; // A deque so jobs never move once added
+	std::vector<JobTiming>							mTimings;
+	JobCounter										mCounter;
+	std::chrono::high_resolution_clock::time_point	mStartTime;
+};
+
+// Work stealing job scheduler. Every worker has its own queue which it pushes to and pops from at the back, so it keeps working
+// on the jobs it just created while they are still in its cache. Workers that run out steal from the front of other queues.
+// Threads waiting on jobs run other jobs rather than blocking, so jobs can safely start and wait on more jobs of their own.
+class JobSystem
+{
+public:
+	JobSystem(int workerCount);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	void Run(JobGraph& graph); // Blocks until every job in the graph has finished. The calling thread runs jobs while it waits. Rethrows the first exception a job threw
+
+	// Runs task over [0, count) split into ranges of at least grainSize, spread over the workers and the calling thread. Blocks until every range
+	// has finished, then rethrows the first exception a range threw. Can be called from inside a job
+	void ParallelFor(int count, int grainSize, const std::function<void(int begin, int end)>& task);
+
+	int GetThreadCount() const { return (int)mWorkers.size() + 1; } // Workers plus the calling thread
+
+	static JobSystem& Instance()
+	{
+		static JobSystem Instance(std::max((int)std::thread::hardware_concurrency() - 1, 0));
+		return Instance;
+	}
+
+private:
+	struct WorkQueue
+	{
+		std::mutex				mutex;
+		std::deque<Job*>		jobs;
+	};
+
+	void WorkerLoop(int queueIndex);
+
+	void Push(Job* job); // Pushes to the back of the calling thread's queue
+	Job* FindJob(); // Pops from the back of the calling thread's queue, or steals from the front of another
+	void Execute(Job* job); // Never throws. Whatever the job throws is kept on its counter
+	void WaitFor(JobCounter& counter); // Runs jobs until the counter reaches zero, then rethrows the first exception its jobs threw
+
+	std::vector<std::thread>					mWorkers;
+	std::vector<std::unique_ptr<WorkQueue>>		mQueues; // Worker i uses queue i + 1. Queue 0 is shared by every other thread
+
+	std::mutex									mSleepMutex;
+	std::condition_variable						mWorkAvailable;
+	std::atomic<int>							mQueuedJobs;
+	bool										mShutdown = false;
+};
@@ -5,6 +5,16 @@ bool Keyboard::KeyIsPressed(unsigned char keycode) const
 	return keystates[keycode];
 }
 
+bool Keyboard::KeyWasPressed(unsigned char keycode) const
+{
+	return keypresses[keycode];
+}
+
+void Keyboard::ClearPresses()
+{
+	keypresses.reset();
+}
+
 Keyboard::Event Keyboard::ReadKey()
 {
 	if (keybuffer.size() > 0u)
@@ -77,6 +87,7 @@ bool Keyboard::AutorepeatIsEnabled() const
 void Keyboard::OnKeyPressed(unsigned char keycode)
 {
 	keystates[keycode] = true;
+	keypresses[keycode] = true;
 	keybuffer.push(Keyboard::Event(Keyboard::Event::Type::Press, keycode));
 	TrimBuffer(keybuffer);
 }
@@ -97,6 +108,7 @@ void Keyboard::OnChar(char character)
 void Keyboard::ClearState()
 {
 	keystates.reset();
+	keypresses.reset();
 }
 
 template<typename T>
@@ -67,6 +67,8 @@ public:
 	Keyboard(const Keyboard&) = delete;
 	Keyboard& operator=(const Keyboard&) = delete;
 	bool KeyIsPressed(unsigned char keycode) const;
+	bool KeyWasPressed(unsigned char keycode) const; // Pressed since the last ClearPresses, even if it has been released again
+	void ClearPresses(); // Called once whatever reads KeyWasPressed has seen the presses
 	Event ReadKey();
 	bool KeyIsEmpty() const;
 	char ReadChar();
@@ -91,6 +93,7 @@ private:
 	static constexpr unsigned int bufferSize = 4u;
 	bool autorepeatEnabled = false;
 	std::bitset<nKeys> keystates;
+	std::bitset<nKeys> keypresses;
 	std::queue<Event> keybuffer;
 	std::queue<char> charbuffer;
 };
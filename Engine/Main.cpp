@@ -1,5 +1,8 @@
 #include "MainWindow.h"
 #include "Engine.h"
+#include "ComponentBenchmark.h"
+#include "PhysicsManager.h"
+#include "RigidBodyWorld.h"
 #include "CustomException.h"
 
 int WINAPI wWinMain(HINSTANCE hInst, HINSTANCE, LPWSTR pArgs, INT)
@@ -13,6 +16,62 @@ int WINAPI wWinMain(HINSTANCE hInst, HINSTANCE, LPWSTR pArgs, INT)
 		try
 		{
 			Engine engine(wnd, screenWidth, screenHeight, filePath);
+
+			// Build steps rather than the game. Run with -compilescenes whenever a level's XML changes
+			if (wnd.GetArgs().find(L"-compilescenes") != std::wstring::npos)
+			{
+				int sceneCount = engine.CompileScenes();
+				wnd.ShowMessageBox(L"Scene Compiler", std::to_wstring(sceneCount) + L" scenes compiled.");
+				return 0;
+			}
+
+			if (wnd.GetArgs().find(L"-benchmarkscenes") != std::wstring::npos)
+			{
+				SceneLoadBenchmark benchmark = engine.BenchmarkSceneLoad("Scene1", 20);
+				wnd.ShowMessageBox(L"Scene Load Benchmark", L"XML: " + std::to_wstring(benchmark.xmlMilliseconds) + L" ms\nCompiled: "
+					+ std::to_wstring(benchmark.binaryMilliseconds) + L" ms\n\nAverage of " + std::to_wstring(benchmark.iterations) + L" loads of Scene1.");
+				return 0;
+			}
+
+			if (wnd.GetArgs().find(L"-benchmarkcomponents") != std::wstring::npos)
+			{
+				ComponentLookupBenchmark benchmark = ComponentBenchmark::Run(1000, 1000);
+				auto timing = [](const std::wstring& name, const ComponentLookupTiming& timing)
+				{
+					return name + L": " + std::to_wstring(timing.typeIDNanoseconds) + L" ns, was " + std::to_wstring(timing.dynamicCastNanoseconds) + L" ns\n";
+				};
+
+				wnd.ShowMessageBox(L"Component Lookup Benchmark", timing(L"GetComponent first", benchmark.firstComponent) + timing(L"GetComponent last", benchmark.lastComponent)
+					+ timing(L"GetComponent interface", benchmark.interfaceComponent) + timing(L"GameObject::Update", benchmark.update) + L"\nAverage per object over "
+					+ std::to_wstring(benchmark.iterations) + L" passes of " + std::to_wstring(benchmark.objectCount) + L" objects with " + std::to_wstring(benchmark.componentsPerObject) + L" components.");
+				return 0;
+			}
+
+			if (wnd.GetArgs().find(L"-benchmarkphysics") != std::wstring::npos)
+			{
+				std::wstring results;
+				int bodyCounts[3] = { 1000, 10000, 100000 };
+				for (int bodyCount : bodyCounts)
+				{
+					RigidBodyIntegrationBenchmark benchmark = RigidBodyWorld::BenchmarkIntegration(bodyCount, 10000000 / bodyCount);
+					results += std::to_wstring(bodyCount) + L" bodies: " + std::to_wstring(benchmark.simdMicroseconds) + L" us SSE2, " + std::to_wstring(benchmark.scalarMicroseconds)
+						+ L" us scalar" + (benchmark.identical ? L"" : L", RESULTS DIFFER") + L"\n";
+				}
+
+				wnd.ShowMessageBox(L"Rigidbody Integration Benchmark", results + L"\nAverage time for one step of every body.");
+				return 0;
+			}
+
+			if (wnd.GetArgs().find(L"-benchmarknarrowphase") != std::wstring::npos)
+			{
+				NarrowphaseBenchmark benchmark = PhysicsManager::BenchmarkNarrowphase(4096, 100);
+				wnd.ShowMessageBox(L"Narrowphase Benchmark", L"Threaded: " + std::to_wstring(benchmark.threadedMilliseconds) + L" ms on " + std::to_wstring(benchmark.threadCount)
+					+ L" threads\nSerial: " + std::to_wstring(benchmark.serialMilliseconds) + L" ms\n" + (benchmark.identical ? L"" : L"RESULTS DIFFER\n") + L"\nAverage of "
+					+ std::to_wstring(benchmark.iterations) + L" runs over " + std::to_wstring(benchmark.pairCount) + L" pairs of " + std::to_wstring(benchmark.colliderCount)
+					+ L" colliders, " + std::to_wstring(benchmark.contactCount) + L" touching.");
+				return 0;
+			}
+
 			engine.PlayStarted();
 			while (wnd.ProcessMessage())
 			{
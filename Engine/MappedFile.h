@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "WinDefines.h"
+
+// Read only view of a whole file, mapped into memory rather than read into a buffer.
+// The OS pages it in as it is touched and the memory goes back as soon as the file is closed
+class MappedFile
+{
+public:
+	MappedFile() { }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& fileName); // False if the file doesn't exist or can't be mapped
+	void Close();
+
+	const char* GetData() const { return mData; }
+	size_t GetSize() const { return mSize; }
+
+private:
+	HANDLE				mFile = INVALID_HANDLE_VALUE;
+	HANDLE				mMapping = nullptr;
+	const char*			mData = nullptr;
+	size_t				mSize = 0;
+};
@@ -275,6 +275,47 @@ inline int DivideCeil(int value, int divisor)
 	return (value % divisor != 0) ? (result + 1) : result;
 }
 
+// Axis aligned bounding box in world space
+struct AABB
+{
+	Vec2 lowerBound;
+	Vec2 upperBound;
+
+	AABB() { }
+	AABB(const Vec2& lower, const Vec2& upper)
+		: lowerBound(lower)
+		, upperBound(upper)
+	{
+	}
+
+	bool Overlaps(const AABB& other) const
+	{
+		return lowerBound.x <= other.upperBound.x && upperBound.x >= other.lowerBound.x
+			&& lowerBound.y <= other.upperBound.y && upperBound.y >= other.lowerBound.y;
+	}
+
+	bool Contains(const AABB& other) const
+	{
+		return lowerBound.x <= other.lowerBound.x && lowerBound.y <= other.lowerBound.y
+			&& upperBound.x >= other.upperBound.x && upperBound.y >= other.upperBound.y;
+	}
+
+	AABB Expanded(float margin) const
+	{
+		return AABB(Vec2(lowerBound.x - margin, lowerBound.y - margin), Vec2(upperBound.x + margin, upperBound.y + margin));
+	}
+
+	float GetPerimeter(void) const
+	{
+		return 2.0f * ((upperBound.x - lowerBound.x) + (upperBound.y - lowerBound.y));
+	}
+};
+
+inline AABB Combine(const AABB& a, const AABB& b)
+{
+	return AABB(Min(a.lowerBound, b.lowerBound), Max(a.upperBound, b.upperBound));
+}
+
 inline bool BiasGreaterThan(float a, float b)
 {
 	const float k_biasRelative = 0.95f;
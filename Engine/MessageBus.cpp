@@ -0,0 +1,112 @@
+#include "MessageBus.h"
+
+MessageBus::MessageBus()
+{
+}
+
+MessageBus::~MessageBus()
+{
+	for (auto& entity : mEntities)
+	{
+		entity.gameObject->mMessageBus = nullptr;
+		entity.gameObject->mMessageSlot = -1;
+	}
+}
+
+void MessageBus::AddGameObject(shared_ptr<GameObject> gameObject)
+{
+	FindOrCreateSlot(gameObject.get());
+
+	for (auto& entry : gameObject->mMessageables)
+		entry.capability->SubscribeToMessages(*this, gameObject.get());
+}
+
+void MessageBus::AddComponent(GameObject * gameObject, IMessageable * messageable)
+{
+	FindOrCreateSlot(gameObject);
+	messageable->SubscribeToMessages(*this, gameObject);
+}
+
+void MessageBus::RemoveComponent(GameObject * gameObject, IComponent * component)
+{
+	auto isComponent = [component](const ComponentCapabilityEntry<IMessageable>& entry) { return entry.component == component; };
+
+	if (gameObject->mMessageBus == this && gameObject->mMessageSlot != -1)
+	{
+		for (auto& receivers : mEntities[gameObject->mMessageSlot].receivers)
+			receivers.erase(std::remove_if(receivers.begin(), receivers.end(), isComponent), receivers.end());
+	}
+
+	for (auto& receivers : mGlobalReceivers)
+		receivers.erase(std::remove_if(receivers.begin(), receivers.end(), isComponent), receivers.end());
+}
+
+void MessageBus::Subscribe(MessageType type, GameObject * gameObject, IComponent * component, IMessageable * receiver)
+{
+	int slot = FindOrCreateSlot(gameObject);
+	mEntities[slot].receivers[type].push_back({ component, receiver });
+}
+
+void MessageBus::SubscribeGlobal(MessageType type, IComponent * component, IMessageable * receiver)
+{
+	mGlobalReceivers[type].push_back({ component, receiver });
+}
+
+void MessageBus::Deliver()
+{
+	for (auto& queue : mQueues)
+	{
+		if (queue != nullptr && queue->GetCount() > 0)
+			queue->Deliver(*this);
+	}
+}
+
+void MessageBus::Dispatch(GameObject * target, IMessage & message)
+{
+	MessageType type = message.GetType();
+
+	if (target != nullptr && target->mMessageBus == this)
+		DispatchTo(mEntities[target->mMessageSlot].receivers[type], message);
+
+	DispatchTo(mGlobalReceivers[type], message);
+}
+
+int MessageBus::GetQueuedCount() const
+{
+	int count = 0;
+	for (auto& queue : mQueues)
+	{
+		if (queue != nullptr)
+			count += queue->GetCount();
+	}
+
+	return count;
+}
+
+int MessageBus::FindOrCreateSlot(GameObject * gameObject)
+{
+	if (gameObject->mMessageBus == this)
+		return gameObject->mMessageSlot;
+
+	if (gameObject->mMessageBus != nullptr)
+		throw std::exception("This object is already in another scene's message bus.");
+
+	EntityReceivers entity;
+	entity.gameObject = gameObject;
+	mEntities.push_back(entity);
+
+	gameObject->mMessageBus = this;
+	gameObject->mMessageSlot = (int)mEntities.size() - 1;
+
+	return gameObject->mMessageSlot;
+}
+
+void MessageBus::DispatchTo(const vector<ComponentCapabilityEntry<IMessageable>>& receivers, IMessage & message)
+{
+	// Indexed as a receiver can subscribe something else, which may move the list
+	for (int i = 0; i < receivers.size(); i++)
+	{
+		if (receivers[i].component->GetActive())
+			receivers[i].capability->RecieveMessage(message);
+	}
+}
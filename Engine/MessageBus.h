@@ -0,0 +1,118 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "GameObject.h"
+
+class MessageBus;
+
+// Queued messages of one type, stored by value next to each other
+class IMessageQueue
+{
+public:
+	virtual ~IMessageQueue() { }
+
+	virtual int GetCount() const = 0;
+	virtual void Deliver(MessageBus& bus) = 0;
+};
+
+template<class T>
+class MessageQueue : public IMessageQueue
+{
+public:
+	void Push(GameObject* target, const T& message)
+	{
+		mTargets.push_back(target);
+		mMessages.push_back(message);
+	}
+
+	virtual int GetCount() const override { return (int)mMessages.size(); }
+	virtual void Deliver(MessageBus& bus) override;
+
+private:
+	std::vector<GameObject*>		mTargets; // Null for messages that only go to global subscribers
+	std::vector<T>					mMessages;
+
+	// Messages queued while delivering wait for the next sync point
+	std::vector<GameObject*>		mDeliveringTargets;
+	std::vector<T>					mDeliveringMessages;
+};
+
+// Routes messages to the components that subscribed to their type, either on a particular object or on every object.
+// Messages are queued when they are sent and only delivered at the sync points the scene calls Deliver from, so a
+// component never has another component's state change underneath it part way through its own update.
+class MessageBus
+{
+public:
+	MessageBus();
+	~MessageBus(); // Detaches every object so none of them try to queue messages on it afterwards
+
+	void AddGameObject(shared_ptr<GameObject> gameObject); // Gives the object a slot and lets its messageable components subscribe
+	void AddComponent(GameObject* gameObject, IMessageable* messageable); // Lets a component added to an object already in the bus subscribe
+	void RemoveComponent(GameObject* gameObject, IComponent* component); // Removes every subscription the component has made. Not safe while delivering
+
+	void Subscribe(MessageType type, GameObject* gameObject, IComponent* component, IMessageable* receiver); // Receives messages of 'type' sent to 'gameObject'
+	void SubscribeGlobal(MessageType type, IComponent* component, IMessageable* receiver); // Receives every message of 'type', whoever it is sent to
+
+	template<class T>
+	void Post(GameObject* target, const T& message); // Queues a message for the next sync point. 'target' can be null to only reach global subscribers
+
+	void Deliver(); // Sync point. Delivers every queued message, one type at a time
+	void Dispatch(GameObject* target, IMessage& message); // Sends a message to its subscribers straight away
+
+	int GetQueuedCount() const;
+
+private:
+	struct EntityReceivers
+	{
+		GameObject*										gameObject;
+		vector<ComponentCapabilityEntry<IMessageable>>	receivers[eMessageTypeCount];
+	};
+
+	int FindOrCreateSlot(GameObject* gameObject);
+	void DispatchTo(const vector<ComponentCapabilityEntry<IMessageable>>& receivers, IMessage& message);
+
+	vector<EntityReceivers>							mEntities;
+	vector<ComponentCapabilityEntry<IMessageable>>	mGlobalReceivers[eMessageTypeCount];
+
+	unique_ptr<IMessageQueue>						mQueues[eMessageTypeCount]; // Created the first time a message of each type is posted
+};
+
+template<class T>
+void MessageQueue<T>::Deliver(MessageBus & bus)
+{
+	mDeliveringTargets.swap(mTargets);
+	mDeliveringMessages.swap(mMessages);
+
+	for (int i = 0; i < mDeliveringMessages.size(); i++)
+		bus.Dispatch(mDeliveringTargets[i], mDeliveringMessages[i]);
+
+	mDeliveringTargets.clear();
+	mDeliveringMessages.clear();
+}
+
+template<class T>
+void MessageBus::Post(GameObject * target, const T & message)
+{
+	// Every MessageType is only ever used by one message class, so the queue for the type always holds T
+	int type = message.GetType();
+	if (mQueues[type] == nullptr)
+		mQueues[type].reset(new MessageQueue<T>());
+
+	static_cast<MessageQueue<T>*>(mQueues[type].get())->Push(target, message);
+}
+
+template<class T>
+void GameObject::QueueMessage(const T & message)
+{
+	if (mMessageBus != nullptr)
+	{
+		mMessageBus->Post(this, message);
+	}
+	else
+	{
+		T messageCopy = message;
+		SendMessageToComponents(messageCopy);
+	}
+}
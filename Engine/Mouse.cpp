@@ -26,6 +26,22 @@ bool Mouse::RightIsPressed() const
 	return rightIsPressed;
 }
 
+bool Mouse::LeftWasPressed() const
+{
+	return leftWasPressed;
+}
+
+bool Mouse::RightWasPressed() const
+{
+	return rightWasPressed;
+}
+
+void Mouse::ClearPresses()
+{
+	leftWasPressed = false;
+	rightWasPressed = false;
+}
+
 bool Mouse::IsInWindow() const
 {
 	return isInWindow;
@@ -72,6 +88,7 @@ void Mouse::OnMouseMove(int newx, int newy)
 void Mouse::OnLeftPressed(int x, int y)
 {
 	leftIsPressed = true;
+	leftWasPressed = true;
 
 	buffer.push(Mouse::Event(Mouse::Event::Type::LPress, *this));
 	TrimBuffer();
@@ -88,6 +105,7 @@ void Mouse::OnLeftReleased(int x, int y)
 void Mouse::OnRightPressed(int x, int y)
 {
 	rightIsPressed = true;
+	rightWasPressed = true;
 
 	buffer.push(Mouse::Event(Mouse::Event::Type::RPress, *this));
 	TrimBuffer();
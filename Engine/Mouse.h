@@ -99,6 +99,9 @@ public:
 	int GetPosY() const;
 	bool LeftIsPressed() const;
 	bool RightIsPressed() const;
+	bool LeftWasPressed() const; // Pressed since the last ClearPresses, even if it has been released again
+	bool RightWasPressed() const;
+	void ClearPresses(); // Called once whatever reads LeftWasPressed and RightWasPressed has seen the presses
 	bool IsInWindow() const;
 	Mouse::Event Read();
 
@@ -127,6 +130,8 @@ private:
 	int y;
 	bool leftIsPressed = false;
 	bool rightIsPressed = false;
+	bool leftWasPressed = false;
+	bool rightWasPressed = false;
 	bool isInWindow = false;
 	std::queue<Event> buffer;
 };
\ No newline at end of file
@@ -1,17 +1,17 @@
 #pragma once
 
-#include <vector>
-#include <fstream>
+#include <map>
+#include <string>
 
 #include "GameObject.h"
-#include "GameComponentFactory.h"
+#include "ComponentParserRegistry.h"
+#include "ObjectPool.h"
+#include "PrefabArchetype.h"
 #include "ICameraGameObject.h"
+#include "SceneNode.h"
 
 #include "Consts.h"
 
-#include "rapidxml.hpp"
-
-using namespace rapidxml;
 using namespace std;
 
 class ObjectManager
@@ -19,36 +19,22 @@ class ObjectManager
 public:
 	ObjectManager();
 
-	shared_ptr<GameObject> CreateObject(xml_node<>* node, ICameraGameObject* cam);
+	shared_ptr<GameObject> CreateObject(const SceneNode& node, ICameraGameObject* cam);
+	shared_ptr<GameObject> CreateObject(const string& tag, int instanceID, const PrefabArchetype& archetype, ICameraGameObject* cam); // An instanceID of -1 gets a new one
 	shared_ptr<GameObject> GetCreatedObject(int instanceID);
 
+	shared_ptr<ObjectPool>& GetPool(const string& poolType); // Null until a component of the scene creates it
+
+	void AddPrefab(const SceneNode& node); // Compiles a Prefab node. Throws if the scene already has a prefab with its name
+	void AddPrefab(const string& name, shared_ptr<PrefabArchetype> prefab);
+	shared_ptr<PrefabArchetype> GetPrefab(const string& name); // Null if the scene doesn't have one
+
 private:
-	IComponent* CreateComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-
-	TransformComponent* ParseTransformComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	SpriteRendererComponent* ParseSpriteRendererComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	SpriteAnimatorComponent* ParseSpriteAnimatorComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	RigidBodyComponent* ParseRigidBodyComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	TextRendererComponent* ParseTextRendererComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	CircleColliderComponent* ParseCircleColliderComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	BoxColliderComponent* ParseBoxColliderComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	TiledBGRenderer* ParseTiledBGRenderer(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	PlayerComponent* ParsePlayerComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	DamageableComponent* ParseDamageableComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	ProjectileComponent* ParseProjectileComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	AIAgentComponent* ParseAIAgentComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	ProjectileManagerComponent* ParseProjectileManagerComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	TriggerBoxComponent* ParseTriggerBoxComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GameCameraComponent* ParseGameCameraComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GUITextComponent* ParseGUITextComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GUITextValueComponent* ParseGUITextValueComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GUITextDamageComponent* ParseGUITextDamageComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GUIButtonComponent* ParseGUIButtonComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GUISpriteRendererComponent* ParseGUISpriteRendererComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	GameManagerComponent* ParseGameManagerComponent(shared_ptr<GameObject> go, xml_node<>* node, ICameraGameObject* cam);
-	
 	int GenerateNewID();
+	void CreateComponents(shared_ptr<GameObject> gameObj, const SceneNode& node, ICameraGameObject* cam);
 
-	map<int, shared_ptr<GameObject>>		mGameObjects;
+	map<int, shared_ptr<GameObject>>			mGameObjects;
+	map<string, shared_ptr<ObjectPool>>			mPools; // Shared by every projectile manager in the scene with the same pool type
+	map<string, shared_ptr<PrefabArchetype>>	mPrefabs;
 };
 
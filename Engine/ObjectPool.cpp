@@ -0,0 +1,98 @@
+#include "ObjectPool.h"
+#include "CommandBuffer.h"
+
+ObjectPool::ObjectPool(const string& type, Factory factory, PoolGrowthPolicy growth, int maxCapacity)
+	: mType(type), mFactory(factory), mGrowth(growth), mMaxCapacity(maxCapacity)
+{
+}
+
+void ObjectPool::Reserve(int capacity)
+{
+	mObjects.reserve(capacity);
+	mObjectOwners.reserve(capacity);
+	mFreeList.reserve(capacity);
+
+	if ((int)mObjects.size() >= capacity)
+		return;
+
+	// Built in one go so the factory only has to set itself up once
+	vector<shared_ptr<GameObject>> built;
+	mFactory(capacity - (int)mObjects.size(), built);
+
+	for (auto& gameObject : built)
+		AddObject(gameObject);
+}
+
+PoolOwnerID ObjectPool::AddOwner(int quota)
+{
+	mOwnerQuotas.push_back(quota);
+	mOwnerActiveCounts.push_back(0);
+	return (PoolOwnerID)mOwnerQuotas.size() - 1;
+}
+
+int ObjectPool::Acquire(PoolOwnerID owner)
+{
+	if (mOwnerQuotas[owner] > 0 && mOwnerActiveCounts[owner] >= mOwnerQuotas[owner])
+	{
+		mStats.quotaRejectCount++;
+		return -1;
+	}
+
+	if (mFreeList.empty() && !Grow())
+	{
+		mStats.failedAcquireCount++;
+		return -1;
+	}
+
+	int index = mFreeList.back();
+	mFreeList.pop_back();
+	mObjectOwners[index] = owner;
+	mOwnerActiveCounts[owner]++;
+
+	mStats.acquireCount++;
+	mStats.activeCount++;
+	mStats.peakActiveCount = std::max(mStats.peakActiveCount, mStats.activeCount);
+
+	return index;
+}
+
+void ObjectPool::Release(int index)
+{
+	if (mObjectOwners[index] == -1)
+		throw std::exception("This object has already been released back to its pool.");
+
+	mOwnerActiveCounts[mObjectOwners[index]]--;
+	mObjectOwners[index] = -1;
+	mFreeList.push_back(index);
+
+	mStats.activeCount--;
+}
+
+bool ObjectPool::Grow()
+{
+	int capacity = (int)mObjects.size();
+	if (mGrowth == ePoolGrowNever || capacity >= mMaxCapacity)
+		return false;
+
+	int growAmount = mGrowth == ePoolGrowDouble ? std::max(capacity, 1) : OBJECT_POOL_GROW_AMOUNT;
+	int newCapacity = std::min(capacity + growAmount, mMaxCapacity);
+
+	mStats.growCount++;
+	Reserve(newCapacity);
+
+	return true;
+}
+
+void ObjectPool::AddObject(shared_ptr<GameObject> gameObject)
+{
+	gameObject->SetActive(false);
+
+	mFreeList.push_back((int)mObjects.size());
+	mObjects.push_back(gameObject);
+	mObjectOwners.push_back(-1);
+	mStats.capacity++;
+
+	// Objects that are already in the scene were added along with the pool, new ones join at the next sync point
+	if (mCommandBuffer != nullptr)
+		mCommandBuffer->Spawn(gameObject);
+}
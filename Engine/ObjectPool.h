@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "GameObject.h"
+
+class CommandBuffer;
+
+struct ObjectPoolStats
+{
+	int			capacity = 0;
+	int			activeCount = 0;
+	int			peakActiveCount = 0; // Most objects ever in use at once. Reserve at least this many to never grow
+	int			acquireCount = 0;
+	int			growCount = 0; // Times the pool ran out and had to build more objects
+	int			failedAcquireCount = 0; // Times the pool ran out and wasn't allowed to grow any further
+	int			quotaRejectCount = 0; // Times an owner asked for more objects than its quota allows
+};
+
+typedef int PoolOwnerID;
+
+// Identical GameObjects of one type, built up front and shared by everything in a scene that needs one.
+// Acquiring pops the free list and releasing pushes it, so neither allocates or depends on how many objects are in use.
+// Running out grows the pool by its growth policy rather than failing, and every growth is counted in the stats.
+class ObjectPool
+{
+public:
+	typedef std::function<void(int count, vector<shared_ptr<GameObject>>& gameObjects)> Factory; // Appends 'count' objects of the pool's type
+
+	ObjectPool(const string& type, Factory factory, PoolGrowthPolicy growth = ePoolGrowDouble, int maxCapacity = OBJECT_POOL_MAX_CAPACITY);
+
+	void Reserve(int capacity); // Builds objects until the pool holds at least 'capacity'. Ignores the maximum capacity
+	PoolOwnerID AddOwner(int quota = 0); // Quota is the most objects the owner can hold at once. 0 for no limit
+
+	int Acquire(PoolOwnerID owner); // Index of an object now belonging to 'owner'. -1 if the owner is at its quota or the pool is full
+	void Release(int index);
+
+	GameObject* GetGameObject(int index) const { return mObjects[index].get(); }
+	const vector<shared_ptr<GameObject>>& GetAllGameObjects() const { return mObjects; } // In use or not
+
+	void SetCommandBuffer(CommandBuffer* commandBuffer) { mCommandBuffer = commandBuffer; } // Objects built once the pool is in a scene are spawned through here
+	bool IsInScene() const { return mCommandBuffer != nullptr; }
+
+	const string& GetType() const { return mType; }
+	int GetOwnerActiveCount(PoolOwnerID owner) const { return mOwnerActiveCounts[owner]; }
+	const ObjectPoolStats& GetStats() const { return mStats; }
+
+private:
+	bool Grow(); // Builds more objects by the growth policy. False if the pool is already at its maximum
+	void AddObject(shared_ptr<GameObject> gameObject);
+
+	string								mType;
+	Factory								mFactory;
+	PoolGrowthPolicy					mGrowth;
+	int									mMaxCapacity;
+
+	vector<shared_ptr<GameObject>>		mObjects;
+	vector<PoolOwnerID>					mObjectOwners; // -1 while the object is free
+	vector<int>							mFreeList; // Index of every free object. Acquired from the back
+
+	vector<int>							mOwnerQuotas;
+	vector<int>							mOwnerActiveCounts;
+
+	CommandBuffer*						mCommandBuffer = nullptr;
+	ObjectPoolStats						mStats;
+};
@@ -1,254 +1,627 @@
 #include "PhysicsManager.h"
 
-#include "CollisionMessage.h"
+#include <cassert>
+#include <chrono>
 
-void PhysicsManager::BuildObjectGrid(int levelWidth, int levelHeight)
+#include "CircleColliderComponent.h"
+#include "ComponentFactory.h"
+#include "TimeOfImpact.h"
+
+PhysicsManager::PhysicsManager()
 {
-	mSetup = true;
-	mObjectGrid = new ObjectGrid(levelWidth + 1, levelHeight + 1 , 100, 100); // Initalise an object grid with cell Size 100,100
+	mBroadphase = new DynamicAABBTree();
+
+	for (int i = 0; i < eCollisionLayerCount; i++)
+		mLayerMatrix[i] = ~0u;
 }
 
 PhysicsManager::~PhysicsManager()
 {
-	delete mObjectGrid;
+	delete mBroadphase;
 }
 
-void PhysicsManager::AddCollider(shared_ptr<GameObject> gameObject, ColliderComponent * collider)
+void PhysicsManager::SetBroadphase(IBroadphase * broadphase)
 {
-	mGameObjects.push_back(gameObject);
+	delete mBroadphase;
+	mBroadphase = broadphase;
+
+	for (int i : mDynamicColliders)
+	{
+		mColliders[i]->BroadphaseProxy = mBroadphase->CreateProxy(mColliders[i]->GetAABB(), i);
+		mColliders[i]->GetTransformComponent()->SetChanged(false);
+	}
+}
+
+void PhysicsManager::AddCollider(GameObject * gameObject, ColliderComponent * collider)
+{
+	mEntities.push_back(gameObject->GetHandle());
 	mColliders.push_back(collider);
+	mColliderLayers.push_back(collider->GetLayerMask());
+	mColliderCollidesWith.push_back(GetCollidesWith(collider->GetLayerMask()));
+
+	// Several colliders can share a body, in which case it is moved by the first one
+	RigidBodyComponent* rigidbody = collider->GetRigidbodyComponent();
+	rigidbody->MoveToWorld(mWorld);
+	if (mWorld.GetTransform(rigidbody->GetBodyIndex()) == nullptr)
+		mWorld.SetTransform(rigidbody->GetBodyIndex(), collider->GetTransformComponent());
+
+	int colliderIndex = (int)mColliders.size() - 1;
+
+	if (rigidbody->GetInverseMass() == 0.0f)
+	{
+		// Static colliders go in the static tree, which is rebuilt once everything has been added rather than per collider
+		mStaticColliders.push_back(colliderIndex);
+		mStaticTreeDirty = true;
+		collider->BroadphaseProxy = -1;
+	}
+	else
+	{
+		mDynamicColliders.push_back(colliderIndex);
+		collider->BroadphaseProxy = mBroadphase->CreateProxy(collider->GetAABB(), colliderIndex);
+	}
 
-	// LEFT, TOP, RIGHT, BOTTOM
-	Rect r = collider->GetRect();
-	int ltrb[4];
-	ltrb[0] = r.LeftX;
-	ltrb[1] = abs(r.TopY);
-	ltrb[2] = r.RightX;
-	ltrb[3] = abs(r.BotY);
+	collider->GetTransformComponent()->SetChanged(false);
+}
 
-	mObjectGrid->Insert(ltrb, (int)mColliders.size() - 1);
-	collider->CentreGridSquare = mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.Centre.y));
-	collider->LeftGridSquare = mObjectGrid->GetCellIndex((int)r.LeftX, (int)abs(r.Centre.y));
-	collider->RightGridSquare = mObjectGrid->GetCellIndex((int)r.RightX, (int)abs(r.Centre.y));
-	collider->BottomGridSquare = mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.BotY));
-	collider->TopGridSquare = mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.TopY));
-	collider->SetPreviousRect(r);
+void PhysicsManager::BakeStaticColliders()
+{
+	vector<AABB> bounds;
+	bounds.reserve(mStaticColliders.size());
+	for (int i : mStaticColliders)
+		bounds.push_back(mColliders[i]->GetAABB());
+
+	mStaticTree.Build(bounds, mStaticColliders);
+	mStaticTreeDirty = false;
 }
 
 void PhysicsManager::Update(float deltaTime)
 {
-	// Holds a vector of collisions that occured between objects
-	vector<Collision> contacts;
-	// Holds a set of every cell index that the collider intersects with. Set is used instead of vector to prevent duplicate cells being inserted
-	set<int> intersectingCells;
+	// Keep last step's contacts around so their impulses can be reused
+	mContacts.swap(mPreviousContacts);
+	mContactPairs.swap(mPreviousContactPairs);
+	mContacts.clear();
+	mContactPairs.clear();
 
-	for (int i = 0; i < mColliders.size(); i++)
+	mTouchingPairs.swap(mPreviousTouchingPairs);
+	mTouchingPairs.clear();
+
+	if (mStaticTreeDirty)
+		BakeStaticColliders();
+
+	UpdateBroadphase();
+	FindPairs();
+	KeepRestingPairs();
+
+	Narrowphase();
+
+	WarmStartContacts();
+	BuildIslands();
+	MarkSimulatedBodies();
+
+	// Integrate forces
+	mWorld.IntegrateForces(deltaTime);
+
+	// Initialize collision
+	for (int i = 0; i < mContacts.size(); ++i)
+		mContacts[i].PrepareToSolve(deltaTime);
+
+	// Apply the impulses the contacts finished with last step
+	for (int i = 0; i < mContacts.size(); ++i)
+		mContacts[i].WarmStart();
+
+	// Resolve collisions. Each iteration refines the accumulated impulses
+	for (int iteration = 0; iteration < mSolverIterations; ++iteration)
 	{
-		// If an objects position has changed it's grid positions might have too so we'll need to update it in the grid
+		for (int i = 0; i < mContacts.size(); ++i)
+			mContacts[i].ResolveCollision();
+	}
+
+	// Integrate velocities
+	StoreContinuousStarts();
+	mWorld.ReadTransforms();
+	mWorld.IntegrateVelocities(deltaTime);
+	mWorld.WriteTransforms();
+	SolveContinuous(deltaTime);
+
+	// Correct positions
+	for (int i = 0; i < mContacts.size(); ++i)
+		mContacts[i].PenetrationCorrection();
+
+	UpdateSleep(deltaTime);
+
+	// Clear all forces
+	mWorld.ClearForces();
+
+	// Components can do anything when they hear about a collision, so they are only told once the step has finished
+	QueueCollisionEvents();
+	mCollisionEvents.Deliver(mColliders, mEntities);
+}
+
+void PhysicsManager::UpdateBroadphase()
+{
+	// Static colliders are never checked. They don't move, so the work here only grows with the number of moving colliders
+	for (int i : mDynamicColliders)
+	{
+		// Only colliders that have moved need their bounds updating. Most of the time the broadphase won't need to change at all
 		if (mColliders[i]->GetActive() && mColliders[i]->GetTransformComponent()->CheckChanged())
 		{
-			UpdateObjectInGrid(mColliders[i], i);
+			// Sleeping bodies don't move themselves, so something else has teleported it
+			if (!mColliders[i]->GetRigidbodyComponent()->IsAwake())
+				mColliders[i]->GetRigidbodyComponent()->SetAwake(true);
+
+			mBroadphase->MoveProxy(mColliders[i]->BroadphaseProxy, mColliders[i]->GetAABB());
+			mColliders[i]->GetTransformComponent()->SetChanged(false);
 		}
 	}
+}
 
-	for (int i = 0; i < mColliders.size(); i++) // For every collider in the scene
+void PhysicsManager::SetLayersCollide(CollisionLayer layerA, CollisionLayer layerB, bool collide)
+{
+	if (collide)
+	{
+		mLayerMatrix[layerA] |= 1u << layerB;
+		mLayerMatrix[layerB] |= 1u << layerA;
+	}
+	else
+	{
+		mLayerMatrix[layerA] &= ~(1u << layerB);
+		mLayerMatrix[layerB] &= ~(1u << layerA);
+	}
+
+	for (int i = 0; i < mColliders.size(); i++)
+		mColliderCollidesWith[i] = GetCollidesWith(mColliderLayers[i]);
+}
+
+unsigned int PhysicsManager::GetCollidesWith(unsigned int layerMask) const
+{
+	unsigned int collidesWith = 0;
+	for (int layer = 0; layer < eCollisionLayerCount; layer++)
+	{
+		if (layerMask & (1u << layer))
+			collidesWith |= mLayerMatrix[layer];
+	}
+
+	return collidesWith;
+}
+
+void PhysicsManager::FindPairs()
+{
+	mPairs.clear();
+
+	for (int i : mDynamicColliders)
 	{
 		ColliderComponent *A = mColliders[i];
 
-		if (!A->GetActive())
+		// Sleeping colliders never query. They are found when a moving collider queries them, which also means sleeping-sleeping
+		// pairs are never generated. Static colliders aren't in this list at all
+		if (!IsSimulated(A))
 			continue;
 
-		GetIntersectingCells(intersectingCells, A);
+		mQueryResults.clear();
+		QueryColliders(A->GetAABB(), mQueryResults);
 
-		for (auto& cell : intersectingCells) // For each cell that this collider intersects
+		for (int element : mQueryResults)
 		{
-			const GridNode* node = mObjectGrid->GetFirstNode(cell); // Get the GetFirstNode grid node in this cell
+			if (element == i || !mColliders[element]->GetActive() || !CanCollide(i, element))
+				continue;
 
-			while (node) // While node is not null go through every collider in the node
-			{
-				int element = node->element;
-				node = mObjectGrid->GetNextNode(node); // Load the GetNextNode element for the GetNextNode loop
+			mPairs.emplace_back(i, element);
+		}
+	}
 
-				if (element <= i) // If the element in this node has an ID less than 'i' that means that we will have already checked this potential collision earlier in the loop
-					continue;
+	// Two moving colliders find each other so remove the duplicates. Sorting also keeps the order pairs are resolved in stable
+	sort(mPairs.begin(), mPairs.end());
+	mPairs.erase(unique(mPairs.begin(), mPairs.end()), mPairs.end());
+}
 
-				ColliderComponent *B = mColliders[element];
-				if (A->GetRigidbodyComponent()->GetInverseMass() == 0 && B->GetRigidbodyComponent()->GetInverseMass() == 0)
-					continue;
+void PhysicsManager::QueryColliders(const AABB & aabb, vector<int>& elements)
+{
+	mBroadphase->Query(aabb, elements);
+	mStaticTree.Query(aabb, elements);
+}
 
-				if (!B->GetActive())
-					continue;
+void PhysicsManager::Narrowphase()
+{
+	// Small batches cost more to hand out than they take to test
+	const int minBatchSize = PHYSICS_NARROWPHASE_MIN_BATCH_SIZE;
+	int threadCount = mNarrowphaseThreading ? JobSystem::Instance().GetThreadCount() : 1;
 
-				Collision collision(A, B);
-				collision.CheckForCollision();
+	// A few batches per thread so one slow batch of polygon pairs doesn't leave the other threads waiting
+	int batchCount = std::max(1, std::min(threadCount * 4, (int)mPairs.size() / minBatchSize));
+	mNarrowphaseBatchSize = ((int)mPairs.size() + batchCount - 1) / batchCount;
 
-				if (collision.GetContactCount()) // If there is a collision the number of contacts will be greater than 0
-				{
-					if (A->GetRigidbodyComponent()->GetActive() && B->GetRigidbodyComponent()->GetActive())
-						contacts.emplace_back(collision);
+	if (mNarrowphaseBatches.size() < batchCount)
+		mNarrowphaseBatches.resize(batchCount);
 
-					CollisionMessage colMsg(mGameObjects[i]);
-					mGameObjects[element]->SendMessageToComponents(colMsg);
+	if (batchCount == 1)
+		RunNarrowphaseBatch(0);
+	else
+		JobSystem::Instance().ParallelFor(batchCount, 1, [this](int begin, int end)
+		{
+			for (int batchIndex = begin; batchIndex < end; batchIndex++)
+				RunNarrowphaseBatch(batchIndex);
+		});
 
-					CollisionMessage colMsg2(mGameObjects[element]);
-					mGameObjects[i]->SendMessageToComponents(colMsg2);
-				}
-			}
+	// Batches cover the pairs in order, so appending them in batch order keeps the contacts sorted by pair no matter
+	// which thread finished first
+	for (int i = 0; i < batchCount; i++)
+	{
+		NarrowphaseBatch& batch = mNarrowphaseBatches[i];
+		for (int j = 0; j < batch.contacts.size(); j++)
+		{
+			mContacts.push_back(batch.contacts[j]);
+			mContactPairs.push_back(mPairs[batch.contactPairs[j]]);
 		}
+
+		for (int pairIndex : batch.touchingPairs)
+			mTouchingPairs.push_back(mPairs[pairIndex]);
 	}
+}
+
+NarrowphaseBenchmark PhysicsManager::BenchmarkNarrowphase(int colliderCount, int iterations)
+{
+	NarrowphaseBenchmark benchmark;
+	benchmark.colliderCount = colliderCount;
+	benchmark.iterations = iterations;
+	benchmark.threadCount = JobSystem::Instance().GetThreadCount();
 
-	/*for (int i = 0; i < mColliders.Size(); ++i)
+	if (colliderCount <= 0 || iterations <= 0)
+		return benchmark;
+
+	// Destroyed before the physics manager, the same way a scene's objects are
+	PhysicsManager physics;
+	vector<shared_ptr<GameObject>> objects;
+
+	// Circles closer than their diameter, so every one overlaps its eight neighbours. Objects aren't in a scene so come from the heap
+	const int columns = (int)sqrt((float)colliderCount);
+	for (int i = 0; i < colliderCount; i++)
 	{
-		ColliderComponent *A = mColliders[i];
+		auto gameObject = GameObject::MakeGameObject("Benchmark", i);
 
-		if (!A->GetActive())
-			continue;
+		TransformComponent* transform = ComponentFactory::MakeTransform(Vec2((float)(i % columns) * 30, (float)(i / columns) * 30), 0, 1);
+		gameObject->AddComponent(transform);
+		RigidBodyComponent* rigidbody = ComponentFactory::MakeRigidbody(0.5f, 0.3f, 0.5f, false, false);
+		gameObject->AddComponent(rigidbody);
+		CircleColliderComponent* collider = ComponentFactory::MakeCircleCollider(25, transform, rigidbody);
+		gameObject->AddComponent(collider);
+
+		physics.AddCollider(gameObject.get(), collider);
+		objects.push_back(gameObject);
+	}
 
-		for (int j = i + 1; j < mColliders.Size(); ++j)
+	physics.UpdateBroadphase();
+	physics.FindPairs();
+	benchmark.pairCount = (int)physics.mPairs.size();
+
+	vector<Collision> contacts[2];
+	vector<BroadphasePair> contactPairs[2];
+	vector<BroadphasePair> touchingPairs[2];
+	float* times[2] = { &benchmark.threadedMilliseconds, &benchmark.serialMilliseconds };
+
+	for (int run = 0; run < 2; run++)
+	{
+		physics.SetNarrowphaseThreading(run == 0);
+
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
 		{
-			ColliderComponent *B = mColliders[j];
-			if (A->GetRigidbodyComponent()->GetInverseMass() == 0 && B->GetRigidbodyComponent()->GetInverseMass() == 0)
-				continue;
+			physics.mContacts.clear();
+			physics.mContactPairs.clear();
+			physics.mTouchingPairs.clear();
+			physics.Narrowphase();
+		}
 
-			if (!B->GetActive())
-				continue;
+		*times[run] = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count() / iterations;
 
-			Collision collision(A, B);
-			collision.CheckCollision();
+		contacts[run] = physics.mContacts;
+		contactPairs[run] = physics.mContactPairs;
+		touchingPairs[run] = physics.mTouchingPairs;
+	}
 
-			if (collision.GetContactCount())
-			{
-				contacts.emplace_back(collision);
+	benchmark.contactCount = (int)contacts[0].size();
+	benchmark.identical = contacts[0].size() == contacts[1].size() && contactPairs[0] == contactPairs[1] && touchingPairs[0] == touchingPairs[1];
+	for (int i = 0; benchmark.identical && i < contacts[0].size(); i++)
+		benchmark.identical = contacts[0][i].HasSameContacts(contacts[1][i]);
+
+	assert(benchmark.identical && "Threaded and serial narrowphase gave different contacts");
+
+	return benchmark;
+}
+
+void PhysicsManager::RunNarrowphaseBatch(int batchIndex)
+{
+	NarrowphaseBatch& batch = mNarrowphaseBatches[batchIndex];
+	batch.contacts.clear();
+	batch.contactPairs.clear();
+	batch.touchingPairs.clear();
 
-				CollisionMessage colMsg(mGameObjects[i]);
-				mGameObjects[j]->SendMessageToComponents(colMsg);
+	int begin = batchIndex * mNarrowphaseBatchSize;
+	int end = std::min(begin + mNarrowphaseBatchSize, (int)mPairs.size());
 
-				CollisionMessage colMsg2(mGameObjects[j]);
-				mGameObjects[i]->SendMessageToComponents(colMsg2);
+	// Only reads the colliders, so any number of batches can run at once
+	for (int i = begin; i < end; i++)
+	{
+		ColliderComponent *A = mColliders[mPairs[i].elementA];
+		ColliderComponent *B = mColliders[mPairs[i].elementB];
+
+		Collision collision(A, B);
+		collision.CheckForCollision();
+
+		if (collision.GetContactCount()) // If there is a collision the number of contacts will be greater than 0
+		{
+			if (A->GetRigidbodyComponent()->GetActive() && B->GetRigidbodyComponent()->GetActive())
+			{
+				batch.contacts.push_back(collision);
+				batch.contactPairs.push_back(i);
 			}
+
+			batch.touchingPairs.push_back(i);
 		}
-	}*/
+	}
+}
 
-	// Integrate forces
-	for (int i = 0; i < mColliders.size(); ++i)
-		IntegrateForces(mColliders[i], deltaTime);
+void PhysicsManager::KeepRestingPairs()
+{
+	// Only checks pairs from last step, so a pair of sleeping colliders that were never touching doesn't become touching here
+	for (auto& pair : mPreviousTouchingPairs)
+	{
+		ColliderComponent* A = mColliders[pair.elementA];
+		ColliderComponent* B = mColliders[pair.elementB];
 
-	// Initialize collision
-	for (int i = 0; i < contacts.size(); ++i)
-		contacts[i].PrepareToSolve(deltaTime);
-		
-	// Resolve collisions
-	for (int i = 0; i < contacts.size(); ++i)
-		contacts[i].ResolveCollision();
+		// Deactivated colliders drop out so their pairs end, as do pairs whose layers have stopped colliding
+		if (A->GetActive() && B->GetActive() && !IsSimulated(A) && !IsSimulated(B) && CanCollide(pair.elementA, pair.elementB))
+			mTouchingPairs.push_back(pair);
+	}
+}
 
-	// Integrate velocities
-	for (int i = 0; i < mColliders.size(); ++i)
-		IntegrateVelocity(mColliders[i], deltaTime);
+void PhysicsManager::QueueCollisionEvents()
+{
+	// Sweeps can add pairs in any order, and can find a pair the narrowphase already has
+	sort(mTouchingPairs.begin(), mTouchingPairs.end());
+	mTouchingPairs.erase(unique(mTouchingPairs.begin(), mTouchingPairs.end()), mTouchingPairs.end());
 
-	// Correct positions
-	for (int i = 0; i < contacts.size(); ++i)
-		contacts[i].PenetrationCorrection();
+	bool queuePersist = mCollisionEvents.WantsPersistEvents();
 
-	// Clear all forces
-	for (int i = 0; i < mColliders.size(); ++i)
+	// Both lists are sorted by pair so walk them together
+	int current = 0;
+	int previous = 0;
+	while (current < mTouchingPairs.size() || previous < mPreviousTouchingPairs.size())
 	{
-		ColliderComponent *b = mColliders[i];
-		b->GetRigidbodyComponent()->SetForce(Vec2(0, 0));
-		b->GetRigidbodyComponent()->SetTorque(0);
+		if (previous == mPreviousTouchingPairs.size() || (current < mTouchingPairs.size() && mTouchingPairs[current] < mPreviousTouchingPairs[previous]))
+		{
+			mCollisionEvents.Push(eCollisionBegin, mTouchingPairs[current].elementA, mTouchingPairs[current].elementB);
+			current++;
+		}
+		else if (current == mTouchingPairs.size() || mPreviousTouchingPairs[previous] < mTouchingPairs[current])
+		{
+			mCollisionEvents.Push(eCollisionEnd, mPreviousTouchingPairs[previous].elementA, mPreviousTouchingPairs[previous].elementB);
+			previous++;
+		}
+		else
+		{
+			if (queuePersist)
+				mCollisionEvents.Push(eCollisionPersist, mTouchingPairs[current].elementA, mTouchingPairs[current].elementB);
+
+			current++;
+			previous++;
+		}
 	}
 }
 
-void PhysicsManager::IntegrateForces(ColliderComponent * collider, float deltaTime)
+void PhysicsManager::WarmStartContacts()
 {
-	if (collider->GetRigidbodyComponent()->GetInverseMass() == 0.0f || !collider->GetActive() || !collider->GetRigidbodyComponent()->GetActive())
-		return;
+	// Both lists are sorted by pair so walk them together
+	int previous = 0;
+	for (int i = 0; i < mContacts.size(); i++)
+	{
+		while (previous < mPreviousContactPairs.size() && mPreviousContactPairs[previous] < mContactPairs[i])
+			previous++;
 
-	collider->GetRigidbodyComponent()->SetVelocity(collider->GetRigidbodyComponent()->GetVelocity() + 
-		(collider->GetRigidbodyComponent()->GetForce() * collider->GetRigidbodyComponent()->GetInverseMass() + 
-		(GRAVITY_VECTOR * (collider->GetRigidbodyComponent()->GetInverseMass() * 3000))) * (deltaTime / 2.0f));
+		if (previous == mPreviousContactPairs.size())
+			break;
 
-	collider->GetRigidbodyComponent()->SetAngularVelocity(collider->GetRigidbodyComponent()->GetAngularVelocity() +
-		collider->GetRigidbodyComponent()->GetTorque() * collider->GetRigidbodyComponent()->GetInverseIntertia() * (deltaTime / 2.0f));
+		if (mPreviousContactPairs[previous] == mContactPairs[i])
+			mContacts[i].WarmStartFrom(mPreviousContacts[previous]);
+	}
 }
 
-void PhysicsManager::IntegrateVelocity(ColliderComponent * collider, float deltaTime)
+bool PhysicsManager::IsSimulated(ColliderComponent * collider)
 {
-	if (collider->GetRigidbodyComponent()->GetInverseMass() == 0.0f || !collider->GetActive() || !collider->GetRigidbodyComponent()->GetActive())
-		return;
+	return collider->GetActive() && collider->GetRigidbodyComponent()->GetInverseMass() != 0.0f && collider->GetRigidbodyComponent()->IsAwake();
+}
 
-	// Calculate position
-	collider->GetTransformComponent()->SetWorldPosition(collider->GetTransformComponent()->GetWorldPosition() + collider->GetRigidbodyComponent()->GetVelocity() * deltaTime);
+void PhysicsManager::MarkSimulatedBodies()
+{
+	mWorld.ClearSimulated();
 
-	if (!collider->GetRigidbodyComponent()->RotationLocked())
+	for (int i : mDynamicColliders)
 	{
-		// Calculate rotation (RADIANS)
-		collider->GetTransformComponent()->SetWorldRotation(collider->GetTransformComponent()->GetWorldRotation()
-			+ collider->GetRigidbodyComponent()->GetAngularVelocity() * deltaTime);
+		if (IsSimulated(mColliders[i]) && mColliders[i]->GetRigidbodyComponent()->GetActive())
+			mWorld.SetSimulated(mColliders[i]->GetRigidbodyComponent()->GetBodyIndex());
+	}
+}
+
+void PhysicsManager::StoreContinuousStarts()
+{
+	mContinuousColliders.clear();
+	mContinuousStarts.clear();
 
-		// Set RB orientation matrix
-		collider->GetRigidbodyComponent()->SetOrientationMatrix(collider->GetTransformComponent()->GetWorldRotation());
+	for (int i : mDynamicColliders)
+	{
+		ColliderComponent* collider = mColliders[i];
+
+		// Only circles are swept
+		if (collider->GetType() != ColliderType::eCircle || !collider->GetRigidbodyComponent()->IsContinuous())
+			continue;
+
+		if (!IsSimulated(collider) || !collider->GetRigidbodyComponent()->GetActive())
+			continue;
+
+		mContinuousColliders.push_back(i);
+		mContinuousStarts.push_back(collider->GetTransformComponent()->GetWorldPosition());
 	}
-	
-	IntegrateForces(collider, deltaTime);
 }
 
-void PhysicsManager::UpdateObjectInGrid(ColliderComponent * collider, int colliderIndex)
+void PhysicsManager::SolveContinuous(float deltaTime)
 {
-	Rect newRect = collider->GetRect();
-	int centreCell = mObjectGrid->GetCellIndex((int)newRect.Centre.x, (int)abs(newRect.Centre.y));
-	int leftCell = mObjectGrid->GetCellIndex((int)newRect.LeftX, (int)abs(newRect.Centre.y));
-	int rightCell = mObjectGrid->GetCellIndex((int)newRect.RightX, (int)abs(newRect.Centre.y));
-	int bottomCell = mObjectGrid->GetCellIndex((int)newRect.Centre.x, (int)abs(newRect.BotY));
-	int topCell = mObjectGrid->GetCellIndex((int)newRect.Centre.x, (int)abs(newRect.TopY));
+	for (int k = 0; k < mContinuousColliders.size(); k++)
+	{
+		int bulletIndex = mContinuousColliders[k];
+		CircleColliderComponent* bullet = static_cast<CircleColliderComponent*>(mColliders[bulletIndex]);
+		TransformComponent* transform = bullet->GetTransformComponent();
+		float radius = bullet->GetRadius();
+
+		Vec2 start = mContinuousStarts[k];
+		Vec2 end = transform->GetWorldPosition();
+		float timeLeft = deltaTime;
+
+		for (int substep = 0; substep < PHYSICS_MAX_CCD_SUBSTEPS; substep++)
+		{
+			AABB sweep = Combine(AABB(start - Vec2(radius, radius), start + Vec2(radius, radius)), AABB(end - Vec2(radius, radius), end + Vec2(radius, radius)));
+
+			mQueryResults.clear();
+			QueryColliders(sweep, mQueryResults);
+
+			// Find the first collider along the sweep
+			float timeOfImpact = 1.0f;
+			int hit = -1;
+			for (int element : mQueryResults)
+			{
+				ColliderComponent* other = mColliders[element];
+				if (element == bulletIndex || !other->GetActive() || !CanCollide(bulletIndex, element))
+					continue;
 
-	if (centreCell != collider->CentreGridSquare ||
-		leftCell != collider->LeftGridSquare ||
-		rightCell != collider->RightGridSquare ||
-		bottomCell != collider->BottomGridSquare ||
-		topCell != collider->TopGridSquare) // A cell has changed
+				// Colliders without an active rigidbody are never solved against, so the discrete step is enough to report them
+				if (!other->GetRigidbodyComponent()->GetActive())
+					continue;
+
+				// Sweeping continuous bodies against each other would need both to move at once
+				if (other->GetRigidbodyComponent()->IsContinuous() && other->GetRigidbodyComponent()->GetInverseMass() != 0.0f)
+					continue;
+
+				float t = CircleTimeOfImpact(radius, start, end, other);
+				if (t < timeOfImpact || (t == timeOfImpact && hit != -1 && element < hit)) // Ties go to the lowest index so the result doesn't depend on the broadphase
+				{
+					timeOfImpact = t;
+					hit = element;
+				}
+			}
+
+			if (hit == -1)
+				break; // The transform is already at the end of the sweep
+
+			Vec2 impact = start + (end - start) * timeOfImpact;
+			transform->SetWorldPosition(impact);
+
+			// Resolve just this one contact so the body leaves the impact with its new velocity
+			Collision collision(bullet, mColliders[hit]);
+			collision.CheckForCollision();
+			if (collision.GetContactCount())
+			{
+				collision.PrepareToSolve(deltaTime);
+				for (int iteration = 0; iteration < mSolverIterations; ++iteration)
+					collision.ResolveCollision();
+
+				mTouchingPairs.emplace_back(bulletIndex, hit);
+
+				if (!mColliders[hit]->GetRigidbodyComponent()->IsAwake())
+					mColliders[hit]->GetRigidbodyComponent()->SetAwake(true);
+			}
+
+			// Out of sub-steps so stay at the impact rather than risk passing through something
+			if (substep == PHYSICS_MAX_CCD_SUBSTEPS - 1)
+				break;
+
+			timeLeft *= 1.0f - timeOfImpact;
+			start = impact;
+			end = impact + bullet->GetRigidbodyComponent()->GetVelocity() * timeLeft;
+			transform->SetWorldPosition(end);
+		}
+	}
+}
+
+void PhysicsManager::BuildIslands()
+{
+	mIslandParent.resize(mColliders.size());
+	for (int i = 0; i < mColliders.size(); i++)
+		mIslandParent[i] = i;
+
+	// Join the islands of every pair of moving colliders that are touching
+	for (int i = 0; i < mContacts.size(); i++)
 	{
-		Rect prevRect = collider->GetPreviousRect();
-		int ltrb[4];
-		ltrb[0] = prevRect.LeftX;
-		ltrb[1] = abs(prevRect.TopY);
-		ltrb[2] = prevRect.RightX;
-		ltrb[3] = abs(prevRect.BotY);
-		mObjectGrid->Erase(ltrb, colliderIndex);
+		int a = mContactPairs[i].elementA;
+		int b = mContactPairs[i].elementB;
 
-		ltrb[0] = newRect.LeftX;
-		ltrb[1] = abs(newRect.TopY);
-		ltrb[2] = newRect.RightX;
-		ltrb[3] = abs(newRect.BotY);
-		mObjectGrid->Insert(ltrb, colliderIndex);
+		if (mColliders[a]->GetRigidbodyComponent()->GetInverseMass() == 0 || mColliders[b]->GetRigidbodyComponent()->GetInverseMass() == 0)
+			continue;
 
-		collider->CentreGridSquare = centreCell;
-		collider->LeftGridSquare = leftCell;
-		collider->RightGridSquare = rightCell;
-		collider->BottomGridSquare = bottomCell;
-		collider->TopGridSquare = topCell;
+		int rootA = FindIslandRoot(a);
+		int rootB = FindIslandRoot(b);
+		if (rootA != rootB)
+			mIslandParent[rootB] = rootA;
+	}
 
-		collider->SetPreviousRect(newRect);
+	// An island is awake if anything in it is awake, so a moving body wakes everything it is touching
+	mIslandAwake.assign(mColliders.size(), false);
+	for (int i = 0; i < mColliders.size(); i++)
+	{
+		if (mColliders[i]->GetRigidbodyComponent()->IsAwake())
+			mIslandAwake[FindIslandRoot(i)] = true;
 	}
 
-	collider->GetTransformComponent()->SetChanged(false);
+	for (int i = 0; i < mColliders.size(); i++)
+	{
+		if (mIslandAwake[FindIslandRoot(i)] && !mColliders[i]->GetRigidbodyComponent()->IsAwake())
+			mColliders[i]->GetRigidbodyComponent()->SetAwake(true);
+	}
 }
 
-void PhysicsManager::GetIntersectingCells(set<int>& intersectingCells, ColliderComponent* collider)
+void PhysicsManager::UpdateSleep(float deltaTime)
 {
-	Rect r = collider->GetRect(); // Get the rect belonging to this collider
+	const float linearToleranceSqr = Sqr(PHYSICS_SLEEP_LINEAR_TOLERANCE);
+
+	mIslandSleepTime.assign(mColliders.size(), FLT_MAX);
 
-	intersectingCells.clear();
-	for (int i = 0; i < 5; i++) // For every important point on the rect, get the cell that it is in
+	for (int i : mDynamicColliders)
 	{
-		if (i == 0) // Centre
-			intersectingCells.insert(mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.Centre.y)));
-		else if (i == 1) // Left
-			intersectingCells.insert(mObjectGrid->GetCellIndex((int)r.LeftX, (int)abs(r.Centre.y)));
-		else if (i == 2) // Right
-			intersectingCells.insert(mObjectGrid->GetCellIndex((int)r.RightX, (int)abs(r.Centre.y)));
-		else if (i == 3) // Top
-			intersectingCells.insert(mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.TopY)));
-		else if (i == 4) // Bottom
-			intersectingCells.insert(mObjectGrid->GetCellIndex((int)r.Centre.x, (int)abs(r.BotY)));
+		if (!IsSimulated(mColliders[i]))
+			continue;
+
+		RigidBodyComponent* rb = mColliders[i]->GetRigidbodyComponent();
+
+		if (!rb->IsSleepingAllowed() || rb->GetVelocity().LenSqr() > linearToleranceSqr || std::abs(rb->GetAngularVelocity()) > PHYSICS_SLEEP_ANGULAR_TOLERANCE)
+			rb->SetSleepTime(0);
+		else
+			rb->SetSleepTime(rb->GetSleepTime() + deltaTime);
+
+		int root = FindIslandRoot(i);
+		mIslandSleepTime[root] = std::min(mIslandSleepTime[root], rb->GetSleepTime());
 	}
+
+	for (int i : mDynamicColliders)
+	{
+		if (IsSimulated(mColliders[i]) && mIslandSleepTime[FindIslandRoot(i)] >= PHYSICS_TIME_TO_SLEEP)
+		{
+			mColliders[i]->GetRigidbodyComponent()->SetAwake(false);
+
+			// Bring the broadphase up to date now. Otherwise the move made this step would look like a teleport next step and wake it again
+			if (mColliders[i]->GetTransformComponent()->CheckChanged())
+			{
+				mBroadphase->MoveProxy(mColliders[i]->BroadphaseProxy, mColliders[i]->GetAABB());
+				mColliders[i]->GetTransformComponent()->SetChanged(false);
+			}
+		}
+	}
+}
+
+int PhysicsManager::FindIslandRoot(int colliderIndex)
+{
+	while (mIslandParent[colliderIndex] != colliderIndex)
+	{
+		// Path halving keeps the sets shallow
+		mIslandParent[colliderIndex] = mIslandParent[mIslandParent[colliderIndex]];
+		colliderIndex = mIslandParent[colliderIndex];
+	}
+
+	return colliderIndex;
 }
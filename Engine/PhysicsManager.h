@@ -1,40 +1,130 @@
 #pragma once
 
 #include <vector>
-#include <set>
 
 #include "Consts.h"
 #include "ColliderComponent.h"
 #include "GameObject.h"
 #include "Collision.h"
-#include "ObjectGrid.h"
+#include "IBroadphase.h"
+#include "DynamicAABBTree.h"
+#include "StaticAABBTree.h"
+#include "JobSystem.h"
+#include "RigidBodyWorld.h"
+#include "CollisionEventQueue.h"
 
 using namespace std;
 
+// Output of one contiguous range of broadphase pairs. Every range is written by a single thread so no locking is needed
+struct NarrowphaseBatch
+{
+	vector<Collision>					contacts;
+	vector<int>							contactPairs; // Index into mPairs of each contact
+	vector<int>							touchingPairs; // Index into mPairs of every pair that is touching, including ones that won't be solved
+};
+
+struct NarrowphaseBenchmark
+{
+	int			colliderCount = 0;
+	int			pairCount = 0;
+	int			contactCount = 0;
+	int			iterations = 0;
+	int			threadCount = 0;
+	float		threadedMilliseconds = 0; // Average time for one narrowphase of every pair, split over the job system
+	float		serialMilliseconds = 0; // The same with SetNarrowphaseThreading(false)
+	bool		identical = false; // Both left the same contacts, bit for bit, and the same touching pairs in the same order
+};
+
 class PhysicsManager
 {
 public:
+	PhysicsManager();
 	~PhysicsManager();
 
-	void BuildObjectGrid(int levelWidth, int levelHeight);
-	void AddCollider(shared_ptr<GameObject> gameObject, ColliderComponent* collider);
+	void SetBroadphase(IBroadphase* broadphase); // Takes ownership of the broadphase and moves every existing moving collider into it
+	void AddCollider(GameObject* gameObject, ColliderComponent* collider); // Colliders with a static rigidbody are baked and must not move afterwards
+	void BakeStaticColliders(); // Rebuilds the static tree. Happens automatically on the first update after a static collider is added
 
 	void Update(float deltaTime);
 
-	bool GetSetup() { return mSetup; }
+	void SetSolverIterations(int iterations) { mSolverIterations = iterations; }
+	int GetSolverIterations() { return mSolverIterations; }
+
+	void SetNarrowphaseThreading(bool enabled) { mNarrowphaseThreading = enabled; } // Results are identical either way, only the speed changes
+	bool GetNarrowphaseThreading() { return mNarrowphaseThreading; }
+
+	void SetLayersCollide(CollisionLayer layerA, CollisionLayer layerB, bool collide); // Every layer collides with every other layer until told otherwise
+	bool GetLayersCollide(CollisionLayer layerA, CollisionLayer layerB) const { return (mLayerMatrix[layerA] & (1u << layerB)) != 0; }
+
+	CollisionEventQueue& GetCollisionEvents() { return mCollisionEvents; } // Subscribe here to hear about colliders touching. Events are delivered at the end of every step
+
+	// Packs 'colliderCount' overlapping circles into a grid and runs the narrowphase over their pairs 'iterations' times, threaded
+	// and then serially. Run the game with -benchmarknarrowphase
+	static NarrowphaseBenchmark BenchmarkNarrowphase(int colliderCount, int iterations);
 
 private:
-	void IntegrateForces(ColliderComponent* collider, float deltaTime);
-	void IntegrateVelocity(ColliderComponent* collider, float deltaTime);
+	void UpdateBroadphase(); // Updates the broadphase bounds of every moving collider whose transform has changed
+	void QueryColliders(const AABB& aabb, vector<int>& elements); // Appends every collider, moving or static, whose bounds overlap 'aabb'
+	void FindPairs(); // Fills mPairs with a sorted list of unique collider pairs whose bounds overlap
+	void Narrowphase(); // Tests every pair for contacts, split over the job system, then merges the results back in pair order
+	void RunNarrowphaseBatch(int batchIndex);
+	void KeepRestingPairs(); // Carries over touching pairs that no collider will query this step, because neither of them can have moved
+	void QueueCollisionEvents(); // Compares this step's touching pairs with the last step's and queues an event for every change
+	void WarmStartContacts(); // Matches this step's contacts with last step's so they start with the impulses they finished with
 
-	void UpdateObjectInGrid(ColliderComponent* collider, int colliderIndex);
-	void GetIntersectingCells(std::set<int>& intersectingCells, ColliderComponent* collider);
+	bool IsSimulated(ColliderComponent* collider); // True if the collider is active, can move and is awake
+	bool CanCollide(int colliderA, int colliderB) const { return (mColliderCollidesWith[colliderA] & mColliderLayers[colliderB]) != 0; } // Checked before any narrowphase work
+	unsigned int GetCollidesWith(unsigned int layerMask) const; // Every layer that a collider in 'layerMask' collides with
+	void MarkSimulatedBodies(); // Tells the world which bodies to integrate this step
 
-	ObjectGrid*							mObjectGrid;
+	void StoreContinuousStarts(); // Remembers where every continuous body starts the step
+	void SolveContinuous(float deltaTime); // Sweeps every continuous body along its path and stops it at the first impact, using the rest of the step to move on from it
+	void BuildIslands(); // Groups moving colliders that are touching each other. Wakes every island that has an awake collider in it
+	void UpdateSleep(float deltaTime); // Puts islands to sleep once every collider in them has been resting long enough
+	int FindIslandRoot(int colliderIndex);
 
-	vector<shared_ptr<GameObject>>		mGameObjects;
+	// Declared first so it is destroyed last, after every collider that could still refer to it
+	RigidBodyWorld						mWorld;
+
+	IBroadphase*						mBroadphase; // Only holds colliders that can move
+	StaticAABBTree						mStaticTree; // Level geometry. Only ever queried by moving colliders
+	bool								mStaticTreeDirty = false;
+
+	vector<EntityHandle>				mEntities; // Owner of each collider
 	vector<ColliderComponent*>			mColliders;
+	vector<int>							mDynamicColliders; // Index into mColliders of every collider in the broadphase
+	vector<int>							mStaticColliders; // Index into mColliders of every collider in the static tree
 
-	bool								mSetup = false;
-};
+	// Layers each collider is in and layers it collides with, copied out of the colliders so filtering pairs stays in cache
+	vector<unsigned int>				mColliderLayers;
+	vector<unsigned int>				mColliderCollidesWith;
+	unsigned int						mLayerMatrix[eCollisionLayerCount]; // Bitmask of the layers each layer collides with. Always symmetric
+
+	vector<BroadphasePair>				mPairs; // Kept between steps so the storage is reused
+	vector<int>							mQueryResults;
+
+	vector<NarrowphaseBatch>			mNarrowphaseBatches; // Kept between steps so the storage is reused
+	int									mNarrowphaseBatchSize = 0;
+	bool								mNarrowphaseThreading = true;
 
+	// Contacts are kept in pair order, from this step and the last, so they can be matched up with a single merge
+	vector<Collision>					mContacts;
+	vector<BroadphasePair>				mContactPairs;
+	vector<Collision>					mPreviousContacts;
+	vector<BroadphasePair>				mPreviousContactPairs;
+
+	// Every touching pair, including ones that aren't solved, from this step and the last
+	vector<BroadphasePair>				mTouchingPairs;
+	vector<BroadphasePair>				mPreviousTouchingPairs;
+	CollisionEventQueue					mCollisionEvents;
+
+	int									mSolverIterations = PHYSICS_SOLVER_ITERATIONS;
+
+	vector<int>							mContinuousColliders;
+	vector<Vec2>						mContinuousStarts;
+
+	// Island of each collider stored as a disjoint set. Static colliders are never joined so they don't connect separate piles
+	vector<int>							mIslandParent;
+	vector<bool>						mIslandAwake; // True if anything in the island is awake. Indexed by the island root
+	vector<float>						mIslandSleepTime; // Shortest time any collider in the island has been resting. Indexed by the island root
+};
@@ -2,11 +2,35 @@
 
 PlayScene::PlayScene(ICameraGameObject * cam) : IScene(cam)
 {
+	// Projectiles only need to hit what they were fired at and the level
+	mPhysicsManager.SetLayersCollide(eLayerProjectile, eLayerProjectile, false);
 
+	// Animation only touches its own state so it runs alongside physics. Backgrounds follow what physics moved so wait for it
+	JobID physics = mStepGraph.AddJob("Physics", [this]
+	{
+		mPhysicsManager.Update(mStepDeltaTime);
+		mTransformHierarchy.Update(); // Resolved once here so the jobs waiting on physics only ever read world transforms
+	});
+	mStepGraph.AddJob("Animation", [this] { mUpdateScheduler.UpdateParallel(eUpdateParallel, mStepDeltaTime); });
+	JobID background = mStepGraph.AddJob("Background", [this] { mUpdateScheduler.UpdateParallel(eUpdateParallelAfterPhysics, mStepDeltaTime); });
+	mStepGraph.AddDependency(background, physics);
+
+	// Anything pressed in the editor, like the click that started play, isn't for the game
+	Keyboard::Instance().ClearPresses();
+	Mouse::Instance().ClearPresses();
+
+	TransformComponent* camTransform = cam->GetComponent<TransformComponent>();
+	if (camTransform != nullptr)
+		mTransforms.push_back(camTransform);
 }
 
 PlayScene::~PlayScene()
 {
+	// Pools belong to this scene's objects, but they are only destroyed along with IScene's members, after mCommandBuffer.
+	// Clear their pointer to it first so nothing they do while being torn down can reach it
+	for (auto& pool : mPools)
+		pool->SetCommandBuffer(nullptr);
+
 	for (auto go : mGameObjects)
 	{
 		if (go)
@@ -19,6 +43,10 @@ PlayScene::~PlayScene()
 void PlayScene::CacheComponents(shared_ptr<GameObject> gameObj)
 {
 	mGameObjects.push_back(gameObj);
+	CacheTransform(gameObj);
+	mUpdateScheduler.AddGameObject(gameObj);
+	mMessageBus.AddGameObject(gameObj);
+	mCommandBuffer.AddGameObject(gameObj.get());
 
 	for (auto component : gameObj->GetAllComponents())
 	{
@@ -26,52 +54,154 @@ void PlayScene::CacheComponents(shared_ptr<GameObject> gameObj)
 
 		if (drawableComponent != nullptr)
 		{
-			mRenderLayers[drawableComponent->RenderLayer].push_back(gameObj);
+			mRenderLayers[drawableComponent->RenderLayer].push_back(gameObj.get());
 		}
 	}
 
-	ColliderComponent* goCollider = gameObj->GetComponent<ColliderComponent>();
-	if (goCollider != nullptr)
-	{
-		if (!mPhysicsManager.GetSetup())
-			SetupPhysics();
-
-		mPhysicsManager.AddCollider(gameObj, goCollider);
-	}
+	CachePhysics(gameObj);
 
 	ProjectileManagerComponent* goProjManager = gameObj->GetComponent<ProjectileManagerComponent>();
 	if (goProjManager != nullptr)
 	{
-		for (auto go : goProjManager->GetAllInactiveGameObjects())
-		{
-			mGameObjects.push_back(go);
-			mPhysicsManager.AddCollider(go, go->GetComponent<ColliderComponent>());
-		}
+		CachePool(goProjManager->GetPool());
 	}
 }
 
-void PlayScene::SetupPhysics()
+void PlayScene::CacheComponent(GameObject * gameObj, IComponent * component)
 {
-	int width = (int)abs(SceneData.levelLeftBounds - SceneData.levelRightBounds);
-	width *= 2;
+	if (dynamic_cast<TransformComponent *> (component) != nullptr || dynamic_cast<RigidBodyComponent *> (component) != nullptr
+		|| dynamic_cast<ColliderComponent *> (component) != nullptr)
+	{
+		throw std::exception("Transforms, rigid bodies and colliders can only be added before an object is in the scene.");
+	}
+
+	IScene::CacheComponent(gameObj, component);
 
-	int height = (int)abs(SceneData.levelTopBounds - SceneData.levelBottomBounds);
-	height *= 2;
+	IUpdateable * updateableComponent = dynamic_cast<IUpdateable *> (component);
+	if (updateableComponent != nullptr)
+		mUpdateScheduler.AddComponent(component, updateableComponent);
 
-	mPhysicsManager.BuildObjectGrid(width, height);
+	IMessageable * messageableComponent = dynamic_cast<IMessageable *> (component);
+	if (messageableComponent != nullptr)
+		mMessageBus.AddComponent(gameObj, messageableComponent);
+
+	ICollisionListener * listenerComponent = dynamic_cast<ICollisionListener *> (component);
+	if (listenerComponent != nullptr)
+		listenerComponent->SubscribeToCollisions(mPhysicsManager.GetCollisionEvents(), gameObj->GetComponent<ColliderComponent>());
+}
+
+void PlayScene::UncacheComponent(GameObject * gameObj, IComponent * component)
+{
+	// Physics and the transform hierarchy refer to these by index and from each other
+	if (dynamic_cast<TransformComponent *> (component) != nullptr || dynamic_cast<RigidBodyComponent *> (component) != nullptr
+		|| dynamic_cast<ColliderComponent *> (component) != nullptr)
+	{
+		throw std::exception("Transforms, rigid bodies and colliders can't be removed from an object in the scene. Deactivate the object instead.");
+	}
+
+	IScene::UncacheComponent(gameObj, component);
+
+	mUpdateScheduler.RemoveComponent(component);
+	mMessageBus.RemoveComponent(gameObj, component);
+
+	ICollisionListener * listenerComponent = dynamic_cast<ICollisionListener *> (component);
+	if (listenerComponent != nullptr)
+		mPhysicsManager.GetCollisionEvents().Unsubscribe(listenerComponent);
 }
 
 void PlayScene::Update(float deltaTime)
+{
+	mAccumulator += deltaTime;
+
+	int steps = 0;
+	while (mAccumulator >= PHYSICS_FIXED_TIMESTEP && steps < PHYSICS_MAX_STEPS_PER_FRAME)
+	{
+		for (auto transform : mTransforms)
+			transform->StorePreviousPose();
+
+		FixedUpdate(PHYSICS_FIXED_TIMESTEP);
+
+		// Presses are kept until a step has seen them, so one made and released on a frame without a step isn't lost
+		Keyboard::Instance().ClearPresses();
+		Mouse::Instance().ClearPresses();
+
+		mAccumulator -= PHYSICS_FIXED_TIMESTEP;
+		steps++;
+	}
+
+	// Too far behind to catch up, so let the game run slower rather than taking longer every frame
+	if (mAccumulator >= PHYSICS_FIXED_TIMESTEP)
+		mAccumulator = std::fmod(mAccumulator, PHYSICS_FIXED_TIMESTEP);
+
+	// Draw how far between the last two steps the frame actually is
+	float alpha = mAccumulator / PHYSICS_FIXED_TIMESTEP;
+	for (auto transform : mTransforms)
+		transform->Interpolate(alpha);
+}
+
+void PlayScene::FixedUpdate(float deltaTime)
 {
 	mCamera->Update(deltaTime);
 
-	// Update object rigid bodies
-	mPhysicsManager.Update(deltaTime);
+	// Physics and the component types that don't depend on anything else run together
+	mStepDeltaTime = deltaTime;
+	mUpdateScheduler.BeginStep();
+	JobSystem::Instance().Run(mStepGraph);
+
+	// Deliver messages sent by collision listeners before anything updates
+	mMessageBus.Deliver();
+
+	// Update the rest of the components, one type at a time
+	mUpdateScheduler.Update(deltaTime);
+
+	// Deliver messages sent while updating, so the step ends with nothing left queued
+	mMessageBus.Deliver();
+
+	// Apply the objects spawned, switched on or off and reparented this step, now nothing is iterating them
+	mCommandBuffer.Playback(*this);
+
+	// Resolve every transform that moved this step in one pass, parents first
+	mTransformHierarchy.Update();
+}
+
+void PlayScene::CachePhysics(shared_ptr<GameObject> gameObj)
+{
+	ColliderComponent* goCollider = gameObj->GetComponent<ColliderComponent>();
+	if (goCollider != nullptr)
+	{
+		mPhysicsManager.AddCollider(gameObj.get(), goCollider);
+	}
 
-	// Update gameobjects
-	for (auto& go : mGameObjects)
+	for (auto component : gameObj->GetAllComponents())
 	{
-		go->Update(deltaTime);
+		ICollisionListener * listenerComponent = dynamic_cast<ICollisionListener *> (component);
+
+		if (listenerComponent != nullptr)
+		{
+			listenerComponent->SubscribeToCollisions(mPhysicsManager.GetCollisionEvents(), goCollider);
+		}
 	}
+}
+
+void PlayScene::CachePool(shared_ptr<ObjectPool> pool)
+{
+	if (!AddPool(pool))
+		return;
+
+	// Pooled objects are ordinary scene objects that start switched off
+	for (auto& go : pool->GetAllGameObjects())
+		CacheComponents(go);
+
+	// Anything the pool builds once the scene is running joins it at the next sync point
+	pool->SetCommandBuffer(&mCommandBuffer);
+}
 
+void PlayScene::CacheTransform(shared_ptr<GameObject> gameObj)
+{
+	TransformComponent* transform = gameObj->GetComponent<TransformComponent>();
+	if (transform != nullptr)
+	{
+		mTransforms.push_back(transform);
+		mTransformHierarchy.AddTransform(transform);
+	}
 }
\ No newline at end of file
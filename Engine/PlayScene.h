@@ -1,7 +1,14 @@
 #pragma once
 
 #include "PhysicsManager.h"
+#include "UpdateScheduler.h"
+#include "MessageBus.h"
+#include "CommandBuffer.h"
+#include "TransformHierarchy.h"
+#include "JobSystem.h"
 #include "IScene.h"
+#include "Keyboard.h"
+#include "Mouse.h"
 
 #include "ICameraGameObject.h"
 
@@ -15,9 +22,28 @@ public:
 
 	void Update(float deltaTime) override;
 	void CacheComponents(shared_ptr<GameObject> gameObj) override;
+	void CacheComponent(GameObject* gameObj, IComponent* component) override; // Transforms, rigid bodies and colliders can't be added once an object is in the scene
+	void UncacheComponent(GameObject* gameObj, IComponent* component) override; // Or removed
+
+	CommandBuffer& GetCommandBuffer() { return mCommandBuffer; } // Spawn objects through here while the scene is running
+
+	const vector<JobTiming>& GetStepTimings() const { return mStepGraph.GetTimings(); } // How long each job in the last fixed step took
 
 private:
-	void SetupPhysics();
+	void FixedUpdate(float deltaTime); // Advances the scene by exactly one fixed step
+	void CacheTransform(shared_ptr<GameObject> gameObj);
+	void CachePhysics(shared_ptr<GameObject> gameObj); // Adds the object's collider and subscribes its collision listeners
+	void CachePool(shared_ptr<ObjectPool> pool); // Adds every object in the pool. Pools shared by several objects are only added once
+
+	PhysicsManager				mPhysicsManager;
+	UpdateScheduler				mUpdateScheduler;
+	MessageBus					mMessageBus; // Declared after the scheduler so it is destroyed first, while every object is still alive
+	CommandBuffer				mCommandBuffer;
+	TransformHierarchy			mTransformHierarchy;
+
+	JobGraph					mStepGraph; // Systems that run at the same time at the start of every fixed step
+	float						mStepDeltaTime = 0;
 
-	PhysicsManager			mPhysicsManager;
+	float						mAccumulator = 0; // Frame time that hasn't been simulated yet
+	vector<TransformComponent*>	mTransforms; // Every transform in the scene, including the camera's, for interpolation
 };
\ No newline at end of file
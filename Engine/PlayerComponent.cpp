@@ -2,7 +2,6 @@
 
 #include "UpdateAnimationSequenceMessage.h"
 #include "AddForceMessage.h"
-#include "CollisionMessage.h"
 
 PlayerComponent::PlayerComponent(TransformComponent* trans, SpriteAnimatorComponent* anim, 
 	RigidBodyComponent* rb, DamageableComponent* dmg, ProjectileManagerComponent* projectileMan, TransformComponent* cameraTransform)
@@ -22,10 +21,9 @@ void PlayerComponent::Update(float deltaTime)
 {
 	if (!mPlayerDamageable->IsDead())
 	{
+		UpdateGrounded();
 		CheckInput();
 		UpdateAnimation();
-
-		mIsGrounded = false;
 	}
 	else 
 	{
@@ -33,30 +31,50 @@ void PlayerComponent::Update(float deltaTime)
 	}
 }
 
-void PlayerComponent::RecieveMessage(IMessage & message)
+void PlayerComponent::SubscribeToCollisions(CollisionEventQueue & events, ColliderComponent * collider)
+{
+	if (collider == nullptr)
+	{
+		throw std::exception("This object requires a collider component.");
+	}
+
+	events.Subscribe(collider, this, "Tile", eCollisionBegin | eCollisionEnd);
+}
+
+void PlayerComponent::RecieveCollisionEvent(const CollisionEvent & event)
 {
-	switch (message.GetType())
+	TransformComponent* tileTrans = event.otherCollider->GetTransformComponent();
+
+	switch (event.type)
 	{
-		case MessageType::eCollision:
-			CollisionMessage& colMsg = static_cast<CollisionMessage &> (message);
-			if (colMsg.CollidedObject->GetTag() == "Tile")
-			{
-				TransformComponent* tileTrans = colMsg.CollidedObject->GetComponent<TransformComponent>();
-
-				// Check if the tile we have collided with is directly beneath us aka we're standing on it. And make sure it's not a tile that is touching our sides
-				if (tileTrans->GetWorldPosition().y > mPlayerTransform->GetWorldPosition().y &&
-					!(tileTrans->GetWorldPosition().x <= mPlayerTransform->GetWorldPosition().x - 32 || 
-						tileTrans->GetWorldPosition().x >= mPlayerTransform->GetWorldPosition().x + 32))
-				{
-					// If it is then we are on the ground
-					mIsGrounded = true;
-				}
-			}
+		case eCollisionBegin:
+			mTouchingTiles.push_back(tileTrans);
+			break;
 
+		case eCollisionEnd:
+			mTouchingTiles.erase(std::remove(mTouchingTiles.begin(), mTouchingTiles.end(), tileTrans), mTouchingTiles.end());
 			break;
 	}
 }
 
+void PlayerComponent::UpdateGrounded()
+{
+	mIsGrounded = false;
+
+	for (auto tileTrans : mTouchingTiles)
+	{
+		// Check if the tile we are touching is directly beneath us aka we're standing on it. And make sure it's not a tile that is touching our sides
+		if (tileTrans->GetWorldPosition().y > mPlayerTransform->GetWorldPosition().y &&
+			!(tileTrans->GetWorldPosition().x <= mPlayerTransform->GetWorldPosition().x - 32 || 
+				tileTrans->GetWorldPosition().x >= mPlayerTransform->GetWorldPosition().x + 32))
+		{
+			// If it is then we are on the ground
+			mIsGrounded = true;
+			return;
+		}
+	}
+}
+
 void PlayerComponent::UpdateAnimation()
 {
 	float downVal = (mPlayerRigidBody->GetVelocity().y > 0) ? mPlayerRigidBody->GetVelocity().y : 0;
@@ -83,8 +101,10 @@ void PlayerComponent::CheckInput()
 {
 	Vec2 dir = Vec2(0.0f, 0.0f);
 
-	// If the player is on the ground they are allowed to jump. The player cannot hold down jump however, they must release the space bar before jumping again
-	if (Keyboard::Instance().KeyIsPressed(VK_SPACE) && mIsGrounded && mCanJump)
+	// If the player is on the ground they are allowed to jump. The player cannot hold down jump however, they must release the space bar before jumping again.
+	// A tap that was over before this step still counts
+	bool jumpPressed = Keyboard::Instance().KeyIsPressed(VK_SPACE) || Keyboard::Instance().KeyWasPressed(VK_SPACE);
+	if (jumpPressed && mIsGrounded && mCanJump)
 	{
 		mCanJump = false;
 		dir.y -= 20;
@@ -117,7 +137,7 @@ void PlayerComponent::CheckInput()
 		mPlayerRigidBody->RecieveMessage(addForceMsg);
 	}
 
-	if (Mouse::Instance().LeftIsPressed())
+	if (Mouse::Instance().LeftIsPressed() || Mouse::Instance().LeftWasPressed())
 	{
 		if (!mIsShooting)
 		{
@@ -133,12 +153,17 @@ void PlayerComponent::CheckInput()
 
 void PlayerComponent::ShootProjectile()
 {
-	auto gameObject = mPlayerProjectiles->GetGameObject("Enemy", PLAYER_PROJECTILE_DAMAGE);
+	static const TagID enemyTag = TagTable::Instance().Intern("Enemy");
+	auto gameObject = mPlayerProjectiles->GetGameObject(enemyTag, PLAYER_PROJECTILE_DAMAGE);
+	if (gameObject == nullptr) // Out of projectiles
+		return;
+
 	Vec2 spawnPos = Vec2(Mouse::Instance().GetPosX() + mCameraTransform->GetWorldPosition().x, Mouse::Instance().GetPosY() + mCameraTransform->GetWorldPosition().y);
 	Vec2 dir = spawnPos - mPlayerTransform->GetWorldPosition();
 	dir.Normalize();
 
 	gameObject->GetComponent<TransformComponent>()->SetWorldPosition(mPlayerTransform->GetWorldPosition() + (dir * 5));
+	gameObject->GetComponent<TransformComponent>()->ResetInterpolation(); // Don't draw it sliding out of the pool
 	gameObject->GetComponent<RigidBodyComponent>()->SetVelocity(Vec2(0, 0));
 	gameObject->GetComponent<RigidBodyComponent>()->ApplyForce(dir * PLAYER_PROJECTILE_SPEED);
 	mPlayerRigidBody->ApplyForce(-dir * PLAYER_SHOOT_KNOCKBACK);
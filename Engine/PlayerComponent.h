@@ -2,8 +2,9 @@
 
 #include "IComponent.h"
 #include "IUpdateable.h"
-#include "IMessageable.h"
+#include "ICollisionListener.h"
 
+#include "CollisionEventQueue.h"
 #include "RigidBodyComponent.h"
 #include "SpriteAnimatorComponent.h"
 #include "DamageableComponent.h"
@@ -14,7 +15,7 @@
 #include "Keyboard.h"
 #include "Mouse.h"
 
-class PlayerComponent : public IComponent, public IUpdateable, public IMessageable
+class PlayerComponent : public IComponent, public IUpdateable, public ICollisionListener
 {
 public:
 	PlayerComponent(TransformComponent* trans, SpriteAnimatorComponent* anim, 
@@ -22,9 +23,12 @@ public:
 	~PlayerComponent();
 
 	virtual void Update(float deltaTime) override;
-	virtual void RecieveMessage(IMessage & message) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderGamePlay; }
+	virtual void SubscribeToCollisions(CollisionEventQueue& events, ColliderComponent* collider) override;
+	virtual void RecieveCollisionEvent(const CollisionEvent& event) override;
 
 private:
+	void UpdateGrounded();
 	void UpdateAnimation();
 	void CheckInput();
 
@@ -38,6 +42,8 @@ private:
 	ProjectileManagerComponent*	mPlayerProjectiles;
 	TransformComponent*			mCameraTransform;
 
+	vector<TransformComponent*>	mTouchingTiles; // Every tile the player is touching, kept up to date by collision events
+
 	bool						mIsGrounded;
 	bool						mCanJump;
 	bool						mIsShooting;
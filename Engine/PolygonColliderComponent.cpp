@@ -77,6 +77,24 @@ Rect PolygonColliderComponent::GetRect()
 	return Rect();
 }
 
+AABB PolygonColliderComponent::GetAABB()
+{
+	Vec2 pos = mTransformComponent->GetWorldPosition();
+	Mat2 orientation = mRigidyBodyComponent->GetOrientationMatrix();
+
+	// Transform every vertex into world space and grow the bounds around it
+	Vec2 v = orientation * Vertices[0] + pos;
+	AABB aabb(v, v);
+	for (int i = 1; i < VertexCount; ++i)
+	{
+		v = orientation * Vertices[i] + pos;
+		aabb.lowerBound = Min(aabb.lowerBound, v);
+		aabb.upperBound = Max(aabb.upperBound, v);
+	}
+
+	return aabb;
+}
+
 void PolygonColliderComponent::SetVerticies(Vec2 * vertices, int count)
 {
 	// No hulls with less than 3 vertices (ensure actual polygon)
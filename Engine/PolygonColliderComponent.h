@@ -11,6 +11,7 @@ public:
 	virtual ColliderType GetType(void) const override { return ColliderType::ePolygon; }
 	virtual void ComputeMass(float density) override;
 	virtual Rect GetRect() override;
+	virtual AABB GetAABB() override;
 
 	virtual Vec2 GetCentre() override { return Vec2(mTransformComponent->GetWorldPosition().x + mHalfWidth, mTransformComponent->GetWorldPosition().y + mHalfHeight); }
 
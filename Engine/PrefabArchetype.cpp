@@ -0,0 +1,176 @@
+#include "PrefabArchetype.h"
+
+#include <cstring>
+
+// Overrides are matched to the prefab's components by type and then by order, so the second override of a type applies to
+// the prefab's second component of that type. Prefabs only have a handful of components, so nothing is indexed
+static SceneNode FindOverride(const SceneNode& overrides, const string& componentType, int occurrence)
+{
+	if (!overrides)
+		return SceneNode();
+
+	for (SceneNode component = overrides.FirstChild("Component"); component; component = component.NextSibling("Component"))
+	{
+		if (componentType == component.GetValue("type") && occurrence-- == 0)
+			return component;
+	}
+
+	return SceneNode();
+}
+
+// How many of the components before 'end' are of the type
+static int CountComponents(const vector<CompiledComponent>& components, const string& componentType, int end)
+{
+	int count = 0;
+	for (int i = 0; i < end; i++)
+		count += components[i].GetType() == componentType ? 1 : 0;
+
+	return count;
+}
+
+// How many of the first 'end' Component children of 'overrides' are of the type
+static int CountOverrides(const SceneNode& overrides, const char* componentType, int end)
+{
+	int count = 0;
+	SceneNode component = overrides.FirstChild("Component");
+	for (int i = 0; i < end; i++, component = component.NextSibling("Component"))
+		count += strcmp(component.GetValue("type"), componentType) == 0 ? 1 : 0;
+
+	return count;
+}
+
+PrefabArchetype::PrefabArchetype(const SceneNode & node)
+{
+	if (node.HasAttribute("tag"))
+		mTag = node.GetString("tag");
+
+	SceneNode component = node.FirstChild("Component");
+	while (component)
+	{
+		mComponents.push_back(ComponentParserRegistry::Instance().Compile(component));
+		component = component.NextSibling("Component");
+	}
+}
+
+shared_ptr<PrefabArchetype> PrefabArchetype::FromXml(const string & xml)
+{
+	// Nothing compiled points back into the document, so it can go once the prefab is built
+	vector<char> xmlData(xml.begin(), xml.end());
+	xmlData.push_back('\0');
+
+	xml_document<> doc;
+	doc.parse<parse_no_data_nodes>(&xmlData[0]);
+
+	if (doc.first_node() == nullptr)
+		throw std::exception("The prefab is empty.");
+
+	return make_shared<PrefabArchetype>(SceneNode(doc.first_node()));
+}
+
+shared_ptr<PrefabArchetype> PrefabArchetype::Override(const char * componentType, const char * attribute, const string & value, int occurrence) const
+{
+	shared_ptr<PrefabArchetype> copy(new PrefabArchetype(*this));
+
+	for (auto& component : copy->mComponents)
+	{
+		if (component.GetType() == componentType && occurrence-- == 0)
+		{
+			component = component.Override(attribute, value);
+			return copy;
+		}
+	}
+
+	throw std::exception(("The prefab doesn't have that many " + string(componentType) + "s to override.").c_str());
+}
+
+shared_ptr<PrefabArchetype> PrefabArchetype::WithTag(const string & tag) const
+{
+	shared_ptr<PrefabArchetype> copy(new PrefabArchetype(*this));
+	copy->mTag = tag;
+	return copy;
+}
+
+shared_ptr<PrefabArchetype> PrefabArchetype::WithOverrides(const SceneNode & node) const
+{
+	shared_ptr<PrefabArchetype> copy(new PrefabArchetype(*this));
+
+	// Components nothing overrides stay shared with this prefab
+	for (int i = 0; i < copy->mComponents.size(); i++)
+	{
+		CompiledComponent& component = copy->mComponents[i];
+
+		SceneNode instanceComponent = FindOverride(node, component.GetType(), CountComponents(mComponents, component.GetType(), i));
+		if (instanceComponent)
+			component = component.Override(instanceComponent);
+	}
+
+	int extraIndex = 0;
+	for (SceneNode extra = node.FirstChild("Component"); extra; extra = extra.NextSibling("Component"), extraIndex++)
+	{
+		const char* componentType = extra.GetValue("type");
+		if (CountOverrides(node, componentType, extraIndex) >= CountComponents(mComponents, componentType, (int)mComponents.size()))
+			copy->mComponents.push_back(ComponentParserRegistry::Instance().Compile(extra));
+	}
+
+	return copy;
+}
+
+shared_ptr<GameObject> PrefabArchetype::Instantiate(int instanceID, ICameraGameObject * camera) const
+{
+	auto gameObject = GameObject::MakeGameObject(mTag, instanceID);
+	BuildComponents(gameObject, nullptr, camera, SceneNode());
+	return gameObject;
+}
+
+void PrefabArchetype::Instantiate(int count, int firstInstanceID, vector<shared_ptr<GameObject>>& gameObjects, ICameraGameObject * camera) const
+{
+	gameObjects.reserve(gameObjects.size() + count);
+
+	// There are no overrides to look for, so every copy is built straight from the compiled arguments
+	for (int i = 0; i < count; i++)
+	{
+		auto gameObject = GameObject::MakeGameObject(mTag, firstInstanceID + i);
+		ComponentParseContext context(nullptr, gameObject, SceneNode(), camera);
+
+		for (const auto& component : mComponents)
+			gameObject->AddComponent(component.Build(context));
+
+		gameObjects.push_back(gameObject);
+	}
+}
+
+void PrefabArchetype::BuildComponents(shared_ptr<GameObject> gameObject, ObjectManager * objects, ICameraGameObject * camera, const SceneNode & overrides) const
+{
+	ComponentParseContext context(objects, gameObject, SceneNode(), camera);
+
+	for (int i = 0; i < mComponents.size(); i++)
+	{
+		const CompiledComponent& component = mComponents[i];
+
+		SceneNode instanceComponent = FindOverride(overrides, component.GetType(), CountComponents(mComponents, component.GetType(), i));
+		if (instanceComponent)
+			gameObject->AddComponent(component.Override(instanceComponent).Build(context));
+		else
+			gameObject->AddComponent(component.Build(context));
+	}
+
+	if (!overrides)
+		return;
+
+	// Components the prefab doesn't have, or has fewer of, are added after its own, so they can refer to them
+	SceneNode extra = overrides.FirstChild("Component");
+	for (int extraIndex = 0; extra; extraIndex++)
+	{
+		const char* componentType = extra.GetValue("type");
+		if (CountOverrides(overrides, componentType, extraIndex) >= CountComponents(mComponents, componentType, (int)mComponents.size()))
+		{
+			IComponent* component = ComponentParserRegistry::Instance().Parse(ComponentParseContext(objects, gameObject, extra, camera));
+			if (extra.HasAttribute("componentinactive"))
+				component->SetActive(false);
+
+			gameObject->AddComponent(component);
+		}
+
+		extra = extra.NextSibling("Component");
+	}
+}
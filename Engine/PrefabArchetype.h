@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComponentParserRegistry.h"
+
+using namespace std;
+
+// A GameObject described once, with every component's attributes already read, so copies can be built from it without
+// going back to the scene. Building a copy only runs each component's factory with the compiled arguments.
+// Scenes define them with Prefab nodes and use them with a GameObject's prefab attribute
+class PrefabArchetype
+{
+public:
+	explicit PrefabArchetype(const SceneNode& node); // Reads the tag and Component children of a Prefab node, or any node laid out like a GameObject
+	static shared_ptr<PrefabArchetype> FromXml(const string& xml); // For prefabs the game defines in code
+
+	// Copy with one attribute of a component changed. 'occurrence' picks between components of the same type, in the order they were added.
+	// Throws if the prefab has no such component
+	shared_ptr<PrefabArchetype> Override(const char* componentType, const char* attribute, const string& value, int occurrence = 0) const;
+	shared_ptr<PrefabArchetype> WithTag(const string& tag) const;
+	shared_ptr<PrefabArchetype> WithOverrides(const SceneNode& node) const; // Copy with the node's Component children compiled in, as BuildComponents would apply them
+
+	// Builds a copy outside of a scene build, so its components can only refer to the copy itself
+	shared_ptr<GameObject> Instantiate(int instanceID, ICameraGameObject* camera = nullptr) const;
+	// Appends 'count' copies to 'gameObjects', numbered on from 'firstInstanceID'. Cheaper than building them one at a time
+	void Instantiate(int count, int firstInstanceID, vector<shared_ptr<GameObject>>& gameObjects, ICameraGameObject* camera = nullptr) const;
+
+	// Adds the prefab's components to an object. Component children of 'overrides' replace the attributes they have on the
+	// prefab's component of the same type, or add components the prefab doesn't have. The nth override of a type goes to the
+	// prefab's nth component of that type, and any beyond the prefab's own are added. 'overrides' can be a null node
+	void BuildComponents(shared_ptr<GameObject> gameObject, ObjectManager* objects, ICameraGameObject* camera, const SceneNode& overrides) const;
+
+	const string& GetTag() const { return mTag; }
+	int GetComponentCount() const { return (int)mComponents.size(); }
+
+private:
+	PrefabArchetype() { }
+
+	string							mTag;
+	vector<CompiledComponent>		mComponents; // In the order they are added, as later components look up earlier ones
+};
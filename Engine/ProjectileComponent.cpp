@@ -1,8 +1,9 @@
 #include "ProjectileComponent.h"
+#include "MessageBus.h"
 
 ProjectileComponent::ProjectileComponent(std::string affectedTag, float lifeSpan, float dmg)
 {
-	mAffectedTag = affectedTag;
+	mAffectedTag = TagTable::Instance().Intern(affectedTag);
 	mLifeLeft = lifeSpan;
 	mStartingLife = lifeSpan;
 	mDamage = dmg;
@@ -14,22 +15,24 @@ ProjectileComponent::~ProjectileComponent()
 {
 }
 
-void ProjectileComponent::RecieveMessage(IMessage & msg)
+void ProjectileComponent::SubscribeToCollisions(CollisionEventQueue & events, ColliderComponent * collider)
 {
-	switch (msg.GetType())
+	if (collider == nullptr)
 	{
-		case MessageType::eCollision:
-		{
-			CollisionMessage& colMsg = static_cast<CollisionMessage &> (msg);
-			if (colMsg.CollidedObject->GetTag() == mAffectedTag)
-			{
-				RecieveDamageMessage recieveDmg(mDamage);
-				colMsg.CollidedObject->SendMessageToComponents(recieveDmg);
-				mIsDead = true;
-			}
+		throw std::exception("This object requires a collider component.");
+	}
+
+	// Not filtered by tag as the affected tag changes every time the projectile is reused
+	events.Subscribe(collider, this, "", eCollisionBegin);
+}
 
-			break;
-		}
+void ProjectileComponent::RecieveCollisionEvent(const CollisionEvent & event)
+{
+	if (event.otherObject->GetTagID() == mAffectedTag)
+	{
+		// Queued so the damage is taken at the next sync point rather than part way through the physics step
+		event.otherObject->QueueMessage(RecieveDamageMessage(mDamage));
+		mIsDead = true;
 	}
 }
 
@@ -55,7 +58,7 @@ void ProjectileComponent::Reset(float lifeSpan)
 	mIsDead = false;
 }
 
-void ProjectileComponent::Reset(std::string affectedTag, float damage)
+void ProjectileComponent::Reset(TagID affectedTag, float damage)
 {
 	mLifeLeft = mStartingLife;
 	mIsDead = false;
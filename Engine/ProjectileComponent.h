@@ -1,28 +1,30 @@
 #pragma once
 
 #include "IComponent.h"
-#include "IMessageable.h"
+#include "ICollisionListener.h"
 #include "IUpdateable.h"
 
-#include "CollisionMessage.h"
+#include "CollisionEventQueue.h"
 #include "RecieveDamageMessage.h"
 
-class ProjectileComponent : public IComponent, public IMessageable, public IUpdateable
+class ProjectileComponent : public IComponent, public ICollisionListener, public IUpdateable
 {
 public:
 	ProjectileComponent(std::string affectedTag, float lifeSpan, float dmg);
 	~ProjectileComponent();
 
-	virtual void RecieveMessage(IMessage &msg) override;
+	virtual void SubscribeToCollisions(CollisionEventQueue& events, ColliderComponent* collider) override;
+	virtual void RecieveCollisionEvent(const CollisionEvent& event) override;
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderProjectiles; }
 
 	bool IsDead() { return mIsDead; }
 	void Reset();
 	void Reset(float lifeSpan);
-	void Reset(std::string affectedTag, float damage);
+	void Reset(TagID affectedTag, float damage);
 
 private:
-	std::string		mAffectedTag;
+	TagID			mAffectedTag;
 	float			mDamage;
 
 	float			mStartingLife;
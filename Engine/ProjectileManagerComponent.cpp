@@ -1,123 +1,72 @@
 #include "ProjectileManagerComponent.h"
 
+ProjectileManagerComponent::ProjectileManagerComponent(shared_ptr<ObjectPool> pool, int quota) : mPool(pool)
+{
+	mPoolOwner = mPool->AddOwner(quota);
+}
+
 ProjectileManagerComponent::~ProjectileManagerComponent()
 {
-	for (auto& g : mActiveGameObjects)
+	// Other managers can still be using the pool
+	for (auto& obj : mActiveGameObjects)
 	{
-		g.GameObject = nullptr;
+		mPool->Release(obj.PoolIndex);
 	}
 
-	for (auto& g : mInactiveGameObjects)
-	{
-		g.GameObject = nullptr;
-	}
+	mActiveGameObjects.clear();
 }
 
-void ProjectileManagerComponent::AddCreatedGameObject(shared_ptr<GameObject> go)
+GameObject* ProjectileManagerComponent::GetGameObject()
 {
-	ProjectilePoolObj obj(go, go->GetComponent<ProjectileComponent>());
-	obj.GameObject->SetActive(false);
-	mInactiveGameObjects.push_back(obj);
-}
+	ProjectilePoolObj* obj = AcquireProjectile();
+	if (obj == nullptr)
+		return nullptr;
 
-void ProjectileManagerComponent::AddCreatedGameObjects(std::vector<shared_ptr<GameObject>> gameObjects)
-{
-	for (auto& go : gameObjects)
-	{
-		ProjectilePoolObj obj(go, go->GetComponent<ProjectileComponent>());
-		obj.GameObject->SetActive(false);
-		mInactiveGameObjects.push_back(obj);
-	}
+	obj->ProjectileComponent->Reset();
+	return obj->GameObject;
 }
 
-shared_ptr<GameObject> ProjectileManagerComponent::GetGameObject()
+GameObject* ProjectileManagerComponent::GetGameObject(TagID affectedTag, float damage)
 {
-	if (mInactiveGameObjects.size() > 0)
-	{
-		ProjectilePoolObj obj = mInactiveGameObjects[0];
-		mActiveGameObjects.push_back(mInactiveGameObjects[0]);
-		mInactiveGameObjects.erase(mInactiveGameObjects.begin());
-
-		// SET ACTIVE
-		obj.GameObject->SetActive(true);
-		obj.ProjectileComponent->Reset();
-
-		return obj.GameObject;
-	}
-	else
-	{
-		throw;
-
+	ProjectilePoolObj* obj = AcquireProjectile();
+	if (obj == nullptr)
 		return nullptr;
-	}
+
+	obj->ProjectileComponent->Reset(affectedTag, damage);
+	return obj->GameObject;
 }
 
-shared_ptr<GameObject> ProjectileManagerComponent::GetGameObject(std::string affectedTag, float damage)
+ProjectileManagerComponent::ProjectilePoolObj * ProjectileManagerComponent::AcquireProjectile()
 {
-	if (mInactiveGameObjects.size() > 0)
-	{
-		ProjectilePoolObj obj = mInactiveGameObjects[0];
-		mActiveGameObjects.push_back(mInactiveGameObjects[0]);
-		mInactiveGameObjects.erase(mInactiveGameObjects.begin());
+	int poolIndex = mPool->Acquire(mPoolOwner);
+	if (poolIndex == -1)
+		return nullptr;
 
-		// SET ACTIVE
-		obj.GameObject->SetActive(true);
-		obj.ProjectileComponent->Reset(affectedTag, damage);
+	GameObject* gameObject = mPool->GetGameObject(poolIndex);
+	mActiveGameObjects.push_back(ProjectilePoolObj(gameObject, gameObject->GetComponent<ProjectileComponent>(), poolIndex));
 
-		return obj.GameObject;
-	}
-	else
-	{
-		throw;
+	// SET ACTIVE
+	gameObject->QueueSetActive(true);
 
-		return nullptr;
-	}
+	return &mActiveGameObjects.back();
 }
 
 void ProjectileManagerComponent::Update(float deltaTime)
 {
+	// The projectiles are in the scene so the scheduler updates them. All that's left here is taking back the ones that died
 	for (int i = 0; i < mActiveGameObjects.size(); i++)
 	{
-		if (mActiveGameObjects[i].ProjectileComponent->IsDead())
-		{
-			ProjectilePoolObj obj = mActiveGameObjects[i];
-			mInactiveGameObjects.push_back(obj);
-			mActiveGameObjects.erase(mActiveGameObjects.begin() + i);
-
-			// SET INACTIVE
-			obj.GameObject->SetActive(false);
-		}
-		else
+		ProjectilePoolObj& obj = mActiveGameObjects[i];
+		if (obj.ProjectileComponent->IsDead())
 		{
-			mActiveGameObjects[i].ProjectileComponent->Update(deltaTime);
+			// SET INACTIVE. Switches off at the scene's next sync point
+			obj.GameObject->QueueSetActive(false);
+			mPool->Release(obj.PoolIndex);
+
+			// Swap the last projectile into the gap and look at this slot again
+			mActiveGameObjects[i] = mActiveGameObjects.back();
+			mActiveGameObjects.pop_back();
+			i--;
 		}
 	}
 }
-
-void ProjectileManagerComponent::Draw(ICamera* cam)
-{
-	for (auto go : mActiveGameObjects)
-	{
-		go.GameObject->Draw(cam);
-	}
-}
-
-std::vector<shared_ptr<GameObject>> ProjectileManagerComponent::GetAllInactiveGameObjects()
-{
-	std::vector<shared_ptr<GameObject>> objs;
-	for (auto go : mInactiveGameObjects)
-	{
-		objs.push_back(go.GameObject);
-	}
-	return objs;
-}
-
-std::vector<shared_ptr<GameObject>> ProjectileManagerComponent::GetAllActiveGameObjects()
-{
-	std::vector<shared_ptr<GameObject>> objs;
-	for (auto go : mActiveGameObjects)
-	{
-		objs.push_back(go.GameObject);
-	}
-	return objs;
-}
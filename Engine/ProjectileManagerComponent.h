@@ -2,44 +2,46 @@
 
 #include "GameObject.h"
 #include "ProjectileComponent.h"
+#include "ObjectPool.h"
 
 #include "IComponent.h"
 #include "IUpdateable.h"
-#include "IDrawable.h"
 
-class ProjectileManagerComponent : public IComponent, public IUpdateable, public IDrawable
+// Hands out projectiles from a pool that can be shared with every other manager in the scene, and takes them back once they die.
+// The projectiles are ordinary scene objects, so the scene draws them like anything else
+class ProjectileManagerComponent : public IComponent, public IUpdateable
 {
 public:
 	struct ProjectilePoolObj 
 	{
 	public:
-		ProjectilePoolObj(shared_ptr<GameObject> obj, ProjectileComponent* proj) :
-			GameObject(obj), ProjectileComponent(proj) { }
+		ProjectilePoolObj(GameObject* obj, ProjectileComponent* proj, int poolIndex) :
+			GameObject(obj), ProjectileComponent(proj), PoolIndex(poolIndex) { }
 
-		shared_ptr<GameObject> GameObject;
+		GameObject* GameObject; // Kept alive by mPool
 		ProjectileComponent* ProjectileComponent;
+		int PoolIndex;
 	};
 
+	ProjectileManagerComponent(shared_ptr<ObjectPool> pool, int quota); // Quota is the most projectiles this manager can have alive at once. 0 for no limit
 	~ProjectileManagerComponent();
 
-	void AddCreatedGameObject(shared_ptr<GameObject> go);
-	void AddCreatedGameObjects(std::vector<shared_ptr<GameObject>> goameObjects);
+	// Get a gameobject from the pool. Null if the pool is empty and can't grow, or this manager is at its quota
+	GameObject* GetGameObject();
+	GameObject* GetGameObject(TagID affectedTag, float damage);
 
-	// Get a gameobject from the pool
-	shared_ptr<GameObject> GetGameObject();
-	shared_ptr<GameObject> GetGameObject(std::string affectedTag, float damage);
+	shared_ptr<ObjectPool> GetPool() { return mPool; }
+	int GetActiveCount() { return (int)mActiveGameObjects.size(); }
 
-	// Get a vector of gameobjects from the pool
-	std::vector<shared_ptr<GameObject>> GetAllInactiveGameObjects();
-	std::vector<shared_ptr<GameObject>> GetAllActiveGameObjects();
-
-	// Update all active projectiles
+	// Release every projectile that has died back to the pool
 	virtual void Update(float deltaTime) override;
-
-	// Draw all active projectiles
-	virtual void Draw(ICamera* cam) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderProjectiles; }
 
 private:
+	ProjectilePoolObj* AcquireProjectile(); // Null if the pool wouldn't give one out
+
 	std::vector<ProjectilePoolObj>	mActiveGameObjects;
-	std::vector<ProjectilePoolObj>	mInactiveGameObjects;
+
+	shared_ptr<ObjectPool>			mPool;
+	PoolOwnerID						mPoolOwner;
 };
\ No newline at end of file
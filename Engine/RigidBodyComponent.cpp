@@ -1,27 +1,19 @@
 #include "RigidBodyComponent.h"
 #include "AddForceMessage.h"
+#include "MessageBus.h"
 
 
 RigidBodyComponent::RigidBodyComponent(float staticF, float dynamicF, float rest)
 {
 	mType = "Rigidbody";
 
-	rigidbodyData = RigidBodyData(Vec2(0,0), 0, 0, Vec2(0,0), 0, 0, 0);
-	
-	rigidbodyData.velocity.Set(0, 0);
-	rigidbodyData.angularVelocity = 0;
-	rigidbodyData.torque = 0;
-	rigidbodyData.force.Set(0, 0);
-	rigidbodyData.orientationMatrix = 0;
-	rigidbodyData.staticFriction = staticF;
-	rigidbodyData.dynamicFriction = dynamicF;
-	rigidbodyData.restitution = rest;
-
-	_rotationLocked = false;
+	mWorld = &RigidBodyWorld::Unassigned();
+	mBodyIndex = mWorld->AddBody(this, RigidBodyData(staticF, dynamicF, rest));
 }
 
 RigidBodyComponent::~RigidBodyComponent()
 {
+	mWorld->RemoveBody(mBodyIndex);
 }
 
 void RigidBodyComponent::RecieveMessage(IMessage & message)
@@ -35,21 +27,62 @@ void RigidBodyComponent::RecieveMessage(IMessage & message)
 	}
 }
 
+void RigidBodyComponent::SubscribeToMessages(MessageBus & bus, GameObject * owner)
+{
+	bus.Subscribe(MessageType::eAddForce, owner, this, this);
+}
+
 void RigidBodyComponent::ApplyForce(const Vec2& f)
 {
-	rigidbodyData.force += (f * 1000000);
+	if (f.x != 0 || f.y != 0)
+		SetAwake(true);
+
+	SetForce(GetForce() + (f * 1000000));
 }
 
 void RigidBodyComponent::ApplyImpulse(const Vec2 & impulse, const Vec2 & contactVector)
 {
-	rigidbodyData.velocity += rigidbodyData.inverseMass * impulse;
-	rigidbodyData.angularVelocity += rigidbodyData.inverseInertia * Cross(contactVector, impulse);
+	SetVelocity(GetVelocity() + GetInverseMass() * impulse);
+	SetAngularVelocity(GetAngularVelocity() + GetInverseIntertia() * Cross(contactVector, impulse));
 }
 
 void RigidBodyComponent::SetStatic()
 {
-	rigidbodyData.intertia = 0.0f;
-	rigidbodyData.inverseInertia = 0.0f;
-	rigidbodyData.mass = 0.0f;
-	rigidbodyData.inverseMass = 0.0f;
+	SetIntertia(0.0f);
+	SetInverseIntertia(0.0f);
+	SetMass(0.0f);
+	SetInverseMass(0.0f);
 }
+
+void RigidBodyComponent::SetAwake(bool awake)
+{
+	Data().sleepTime = 0;
+
+	if (awake == Data().awake)
+		return;
+
+	Data().awake = awake;
+
+	if (!awake)
+	{
+		// A sleeping body must not carry any motion into the step it wakes up in
+		SetVelocity(Vec2(0, 0));
+		SetAngularVelocity(0);
+		SetForce(Vec2(0, 0));
+		SetTorque(0);
+	}
+}
+
+void RigidBodyComponent::SetSleepingAllowed(bool allowed)
+{
+	Data().sleepingAllowed = allowed;
+
+	if (!allowed)
+		SetAwake(true);
+}
+
+void RigidBodyComponent::MoveToWorld(RigidBodyWorld & world)
+{
+	if (mWorld != &world)
+		mWorld->TransferBody(mBodyIndex, world);
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "IComponent.h"
 #include "IUpdateable.h"
 #include "IMessageable.h"
+#include "RigidBodyWorld.h"
 
 class RigidBodyComponent : public IComponent, public IMessageable
 {
@@ -10,58 +11,83 @@ public:
 	RigidBodyComponent(float staticF, float dynamicF, float rest);
 	~RigidBodyComponent();
 
+	RigidBodyComponent(const RigidBodyComponent&) = delete;
+	RigidBodyComponent& operator=(const RigidBodyComponent&) = delete;
+
 	virtual void RecieveMessage(IMessage& message) override;
+	virtual void SubscribeToMessages(MessageBus& bus, GameObject* owner) override;
 
 	void ApplyForce(const Vec2& f);
 	void ApplyImpulse(const Vec2& impulse, const Vec2& contactVector);
 
 	void SetStatic();
-	void LockRotation() { _rotationLocked = true; }
+	void LockRotation() { Data().rotationLocked = true; }
+
+	// Continuous bodies are swept from where they started the step to where they ended it so they can't pass through thin colliders.
+	// Only worth the cost for small, fast bodies such as projectiles
+	void SetContinuous(bool continuous) { Data().continuous = continuous; }
+	bool IsContinuous() { return Data().continuous; }
+
+	// Sleeping bodies are skipped by the physics step until something touches, pushes or moves them
+	void SetAwake(bool awake);
+	bool IsAwake() { return Data().awake; }
+	void SetSleepingAllowed(bool allowed);
+	bool IsSleepingAllowed() { return Data().sleepingAllowed; }
+	float GetSleepTime() { return Data().sleepTime; }
+	void SetSleepTime(float time) { Data().sleepTime = time; }
+
+	// The body's state lives in a world. Bodies start in the unassigned world and are moved when they join a physics scene
+	void MoveToWorld(RigidBodyWorld& world);
+	RigidBodyWorld* GetWorld() { return mWorld; }
+	int GetBodyIndex() { return mBodyIndex; }
 
 #pragma region Getters and Setters
 
-	Mat2 GetOrientationMatrix() { return rigidbodyData.orientationMatrix; }
-	void SetOrientationMatrix(Mat2 mat) { rigidbodyData.orientationMatrix = mat; }
+	Mat2 GetOrientationMatrix() { return Data().orientationMatrix; }
+	void SetOrientationMatrix(Mat2 mat) { Data().orientationMatrix = mat; }
 
-	Vec2 GetVelocity() { return rigidbodyData.velocity; }
-	void SetVelocity(Vec2 vel) { rigidbodyData.velocity = vel; }
+	Vec2 GetVelocity() { return Vec2(mWorld->mVelocityX[mBodyIndex], mWorld->mVelocityY[mBodyIndex]); }
+	void SetVelocity(Vec2 vel) { mWorld->mVelocityX[mBodyIndex] = vel.x; mWorld->mVelocityY[mBodyIndex] = vel.y; }
 
-	float GetAngularVelocity() { return rigidbodyData.angularVelocity; }
-	void SetAngularVelocity(float vel) { rigidbodyData.angularVelocity = vel; }
+	float GetAngularVelocity() { return mWorld->mAngularVelocity[mBodyIndex]; }
+	void SetAngularVelocity(float vel) { mWorld->mAngularVelocity[mBodyIndex] = vel; }
 
-	float GetTorque() { return rigidbodyData.torque; }
-	void SetTorque(float torq) { rigidbodyData.torque = torq; }
+	float GetTorque() { return mWorld->mTorque[mBodyIndex]; }
+	void SetTorque(float torq) { mWorld->mTorque[mBodyIndex] = torq; }
 
-	Vec2 GetForce() { return rigidbodyData.force; }
-	void SetForce(Vec2 forc) { rigidbodyData.force = forc; }
+	Vec2 GetForce() { return Vec2(mWorld->mForceX[mBodyIndex], mWorld->mForceY[mBodyIndex]); }
+	void SetForce(Vec2 forc) { mWorld->mForceX[mBodyIndex] = forc.x; mWorld->mForceY[mBodyIndex] = forc.y; }
 
-	float GetIntertia() { return rigidbodyData.intertia; }
-	void SetIntertia(float intert) { rigidbodyData.intertia = intert; }
+	float GetIntertia() { return Data().intertia; }
+	void SetIntertia(float intert) { Data().intertia = intert; }
 
-	float GetInverseIntertia() { return rigidbodyData.inverseInertia; }
-	void SetInverseIntertia(float intert) { rigidbodyData.inverseInertia = intert; }
+	float GetInverseIntertia() { return mWorld->mInverseInertia[mBodyIndex]; }
+	void SetInverseIntertia(float intert) { mWorld->mInverseInertia[mBodyIndex] = intert; }
 
-	float GetMass() { return rigidbodyData.mass; }
-	void SetMass(float m) { rigidbodyData.mass = m; }
+	float GetMass() { return Data().mass; }
+	void SetMass(float m) { Data().mass = m; }
 
-	float GetInverseMass() { return rigidbodyData.inverseMass; }
-	void SetInverseMass(float im) { rigidbodyData.inverseMass = im; }
+	float GetInverseMass() { return mWorld->mInverseMass[mBodyIndex]; }
+	void SetInverseMass(float im) { mWorld->mInverseMass[mBodyIndex] = im; }
 
-	float GetStaticFriction() { return rigidbodyData.staticFriction; }
-	void SetStaticFriction(float frict) { rigidbodyData.staticFriction = frict; }
+	float GetStaticFriction() { return Data().staticFriction; }
+	void SetStaticFriction(float frict) { Data().staticFriction = frict; }
 
-	float GetDynamicFriction() { return rigidbodyData.dynamicFriction; }
-	void SetDynamicFriction(float frict) { rigidbodyData.dynamicFriction = frict; }
+	float GetDynamicFriction() { return Data().dynamicFriction; }
+	void SetDynamicFriction(float frict) { Data().dynamicFriction = frict; }
 
-	float GetRestitution() { return rigidbodyData.restitution; }
-	void SetRestitution(float rest) { rigidbodyData.restitution = rest; }
+	float GetRestitution() { return Data().restitution; }
+	void SetRestitution(float rest) { Data().restitution = rest; }
 
-	bool RotationLocked() {	return _rotationLocked;	}
+	bool RotationLocked() {	return Data().rotationLocked; }
 
 #pragma endregion
 
 private:
-	RigidBodyData rigidbodyData = RigidBodyData(Vec2(0, 0), 0, 0, Vec2(0, 0), 0, 0, 0);
-	bool				_rotationLocked;
-};
+	friend class RigidBodyWorld;
 
+	RigidBodyData& Data() { return mWorld->mData[mBodyIndex]; }
+
+	RigidBodyWorld*		mWorld;
+	int					mBodyIndex;
+};
@@ -0,0 +1,332 @@
+#include "RigidBodyWorld.h"
+
+#include <chrono>
+
+#include "RigidBodyComponent.h"
+#include "TransformComponent.h"
+
+// SSE2 is always available on x64 and is enabled by default for x86 builds
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define RIGIDBODY_WORLD_SSE
+#include <emmintrin.h>
+#endif
+
+static thread_local RigidBodyWorld* tUnassignedWorld = nullptr;
+
+RigidBodyWorld::RigidBodyWorld() : RigidBodyWorld(false)
+{
+}
+
+RigidBodyWorld::RigidBodyWorld(bool isUnassigned) : mIsUnassigned(isUnassigned)
+{
+}
+
+RigidBodyWorld::~RigidBodyWorld()
+{
+	if (mIsUnassigned)
+		return;
+
+	// Taking from the back means nothing has to be swapped into the gaps
+	while (GetBodyCount() > 0)
+		TransferBody(GetBodyCount() - 1, Unassigned());
+}
+
+RigidBodyWorld & RigidBodyWorld::Unassigned()
+{
+	static RigidBodyWorld Instance(true);
+	return tUnassignedWorld != nullptr ? *tUnassignedWorld : Instance;
+}
+
+void RigidBodyWorld::SetUnassigned(RigidBodyWorld * world)
+{
+	tUnassignedWorld = world;
+}
+
+int RigidBodyWorld::AddBody(RigidBodyComponent * owner, const RigidBodyData & data)
+{
+	mPositionX.push_back(0);
+	mPositionY.push_back(0);
+	mRotation.push_back(0);
+	mVelocityX.push_back(0);
+	mVelocityY.push_back(0);
+	mAngularVelocity.push_back(0);
+	mForceX.push_back(0);
+	mForceY.push_back(0);
+	mTorque.push_back(0);
+	mInverseMass.push_back(1); // Bodies start dynamic. ComputeMass gives them their real mass and SetStatic zeroes it
+	mInverseInertia.push_back(0);
+	mSimulated.push_back(0);
+
+	mData.push_back(data);
+	mTransforms.push_back(nullptr);
+	mOwners.push_back(owner);
+
+	return GetBodyCount() - 1;
+}
+
+void RigidBodyWorld::RemoveBody(int index)
+{
+	int last = GetBodyCount() - 1;
+	if (index != last)
+	{
+		CopyBody(last, index);
+		mOwners[index]->mBodyIndex = index;
+	}
+
+	PopBody();
+}
+
+void RigidBodyWorld::TransferBody(int index, RigidBodyWorld & destination)
+{
+	RigidBodyComponent* owner = mOwners[index];
+
+	int newIndex = destination.AddBody(owner, mData[index]);
+	destination.mPositionX[newIndex] = mPositionX[index];
+	destination.mPositionY[newIndex] = mPositionY[index];
+	destination.mRotation[newIndex] = mRotation[index];
+	destination.mVelocityX[newIndex] = mVelocityX[index];
+	destination.mVelocityY[newIndex] = mVelocityY[index];
+	destination.mAngularVelocity[newIndex] = mAngularVelocity[index];
+	destination.mForceX[newIndex] = mForceX[index];
+	destination.mForceY[newIndex] = mForceY[index];
+	destination.mTorque[newIndex] = mTorque[index];
+	destination.mInverseMass[newIndex] = mInverseMass[index];
+	destination.mInverseInertia[newIndex] = mInverseInertia[index];
+	destination.mTransforms[newIndex] = mTransforms[index];
+
+	owner->mWorld = &destination;
+	owner->mBodyIndex = newIndex;
+
+	RemoveBody(index);
+}
+
+void RigidBodyWorld::ClearSimulated()
+{
+	std::fill(mSimulated.begin(), mSimulated.end(), 0);
+}
+
+void RigidBodyWorld::ReadTransforms()
+{
+	for (int i = 0; i < GetBodyCount(); i++)
+	{
+		if (!mSimulated[i] || mTransforms[i] == nullptr)
+			continue;
+
+		Vec2 position = mTransforms[i]->GetWorldPosition();
+		mPositionX[i] = position.x;
+		mPositionY[i] = position.y;
+		mRotation[i] = mTransforms[i]->GetWorldRotation();
+	}
+}
+
+void RigidBodyWorld::WriteTransforms()
+{
+	for (int i = 0; i < GetBodyCount(); i++)
+	{
+		if (!mSimulated[i] || mTransforms[i] == nullptr)
+			continue;
+
+		mTransforms[i]->SetWorldPosition(Vec2(mPositionX[i], mPositionY[i]));
+
+		if (!mData[i].rotationLocked)
+		{
+			mTransforms[i]->SetWorldRotation(mRotation[i]);
+			mData[i].orientationMatrix.Set(mTransforms[i]->GetWorldRotation());
+		}
+	}
+}
+
+void RigidBodyWorld::IntegrateForces(float deltaTime)
+{
+	const float halfDeltaTime = deltaTime / 2.0f;
+	const float gravityX = GRAVITY_VECTOR.x;
+	const float gravityY = GRAVITY_VECTOR.y;
+	const int count = GetBodyCount();
+
+	int i = 0;
+
+	// The SIMD path does exactly the same operations in the same order as the scalar path so both give identical results.
+	// Bodies that aren't simulated are calculated anyway and then masked back to their old values
+#ifdef RIGIDBODY_WORLD_SSE
+	const __m128 halfDeltaTime4 = _mm_set1_ps(halfDeltaTime);
+	const __m128 gravityX4 = _mm_set1_ps(gravityX);
+	const __m128 gravityY4 = _mm_set1_ps(gravityY);
+	const __m128 gravityScale4 = _mm_set1_ps(3000.0f);
+
+	for (; mSimdEnabled && i + 4 <= count; i += 4)
+	{
+		__m128 mask = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&mSimulated[i]));
+		__m128 inverseMass = _mm_loadu_ps(&mInverseMass[i]);
+		__m128 gravityMass = _mm_mul_ps(inverseMass, gravityScale4);
+
+		__m128 velocityX = _mm_loadu_ps(&mVelocityX[i]);
+		__m128 accelerationX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&mForceX[i]), inverseMass), _mm_mul_ps(gravityX4, gravityMass));
+		__m128 newVelocityX = _mm_add_ps(velocityX, _mm_mul_ps(accelerationX, halfDeltaTime4));
+		_mm_storeu_ps(&mVelocityX[i], _mm_or_ps(_mm_and_ps(mask, newVelocityX), _mm_andnot_ps(mask, velocityX)));
+
+		__m128 velocityY = _mm_loadu_ps(&mVelocityY[i]);
+		__m128 accelerationY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&mForceY[i]), inverseMass), _mm_mul_ps(gravityY4, gravityMass));
+		__m128 newVelocityY = _mm_add_ps(velocityY, _mm_mul_ps(accelerationY, halfDeltaTime4));
+		_mm_storeu_ps(&mVelocityY[i], _mm_or_ps(_mm_and_ps(mask, newVelocityY), _mm_andnot_ps(mask, velocityY)));
+
+		__m128 angularVelocity = _mm_loadu_ps(&mAngularVelocity[i]);
+		__m128 angularAcceleration = _mm_mul_ps(_mm_loadu_ps(&mTorque[i]), _mm_loadu_ps(&mInverseInertia[i]));
+		__m128 newAngularVelocity = _mm_add_ps(angularVelocity, _mm_mul_ps(angularAcceleration, halfDeltaTime4));
+		_mm_storeu_ps(&mAngularVelocity[i], _mm_or_ps(_mm_and_ps(mask, newAngularVelocity), _mm_andnot_ps(mask, angularVelocity)));
+	}
+#endif
+
+	// Remainder, or everything when SIMD isn't available
+	for (; i < count; i++)
+	{
+		if (!mSimulated[i])
+			continue;
+
+		float gravityMass = mInverseMass[i] * 3000.0f;
+		mVelocityX[i] = mVelocityX[i] + (mForceX[i] * mInverseMass[i] + gravityX * gravityMass) * halfDeltaTime;
+		mVelocityY[i] = mVelocityY[i] + (mForceY[i] * mInverseMass[i] + gravityY * gravityMass) * halfDeltaTime;
+		mAngularVelocity[i] = mAngularVelocity[i] + (mTorque[i] * mInverseInertia[i]) * halfDeltaTime;
+	}
+}
+
+void RigidBodyWorld::IntegrateVelocities(float deltaTime)
+{
+	const int count = GetBodyCount();
+
+	int i = 0;
+
+#ifdef RIGIDBODY_WORLD_SSE
+	const __m128 deltaTime4 = _mm_set1_ps(deltaTime);
+
+	for (; mSimdEnabled && i + 4 <= count; i += 4)
+	{
+		__m128 mask = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&mSimulated[i]));
+
+		__m128 positionX = _mm_loadu_ps(&mPositionX[i]);
+		__m128 newPositionX = _mm_add_ps(positionX, _mm_mul_ps(_mm_loadu_ps(&mVelocityX[i]), deltaTime4));
+		_mm_storeu_ps(&mPositionX[i], _mm_or_ps(_mm_and_ps(mask, newPositionX), _mm_andnot_ps(mask, positionX)));
+
+		__m128 positionY = _mm_loadu_ps(&mPositionY[i]);
+		__m128 newPositionY = _mm_add_ps(positionY, _mm_mul_ps(_mm_loadu_ps(&mVelocityY[i]), deltaTime4));
+		_mm_storeu_ps(&mPositionY[i], _mm_or_ps(_mm_and_ps(mask, newPositionY), _mm_andnot_ps(mask, positionY)));
+
+		// Locked bodies are integrated too but WriteTransforms ignores their rotation
+		__m128 rotation = _mm_loadu_ps(&mRotation[i]);
+		__m128 newRotation = _mm_add_ps(rotation, _mm_mul_ps(_mm_loadu_ps(&mAngularVelocity[i]), deltaTime4));
+		_mm_storeu_ps(&mRotation[i], _mm_or_ps(_mm_and_ps(mask, newRotation), _mm_andnot_ps(mask, rotation)));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		if (!mSimulated[i])
+			continue;
+
+		mPositionX[i] = mPositionX[i] + mVelocityX[i] * deltaTime;
+		mPositionY[i] = mPositionY[i] + mVelocityY[i] * deltaTime;
+		mRotation[i] = mRotation[i] + mAngularVelocity[i] * deltaTime;
+	}
+
+	IntegrateForces(deltaTime);
+}
+
+RigidBodyIntegrationBenchmark RigidBodyWorld::BenchmarkIntegration(int bodyCount, int iterations)
+{
+	RigidBodyWorld worlds[2];
+	worlds[1].SetSimdEnabled(false);
+
+	// Both worlds start with the same spread of masses, forces and velocities. Every eighth body is left out, as bodies that
+	// are asleep or static would be
+	for (auto& world : worlds)
+	{
+		for (int i = 0; i < bodyCount; i++)
+		{
+			int index = world.AddBody(nullptr, RigidBodyData(0.5f, 0.3f, 0.5f));
+			world.mInverseMass[index] = 1.0f / (1 + i % 7);
+			world.mInverseInertia[index] = 1.0f / (1 + i % 5);
+			world.mVelocityX[index] = (float)(i % 11) - 5;
+			world.mVelocityY[index] = (float)(i % 13) - 6;
+			world.mForceX[index] = (float)(i % 3);
+			world.mTorque[index] = (float)(i % 4) * 0.1f;
+
+			if (i % 8 != 0)
+				world.SetSimulated(index);
+		}
+	}
+
+	RigidBodyIntegrationBenchmark benchmark;
+	benchmark.bodyCount = bodyCount;
+	benchmark.iterations = iterations;
+#ifdef RIGIDBODY_WORLD_SSE
+	benchmark.simdAvailable = true;
+#endif
+
+	float* times[2] = { &benchmark.simdMicroseconds, &benchmark.scalarMicroseconds };
+	for (int w = 0; w < 2; w++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+			worlds[w].IntegrateVelocities(PHYSICS_FIXED_TIMESTEP);
+
+		*times[w] = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+	}
+
+	benchmark.identical = worlds[0].mPositionX == worlds[1].mPositionX && worlds[0].mPositionY == worlds[1].mPositionY && worlds[0].mRotation == worlds[1].mRotation
+		&& worlds[0].mVelocityX == worlds[1].mVelocityX && worlds[0].mVelocityY == worlds[1].mVelocityY && worlds[0].mAngularVelocity == worlds[1].mAngularVelocity;
+
+	// The bodies have no components, so they are removed from the back rather than handed to the unassigned world
+	for (auto& world : worlds)
+	{
+		while (world.GetBodyCount() > 0)
+			world.RemoveBody(world.GetBodyCount() - 1);
+	}
+
+	return benchmark;
+}
+
+void RigidBodyWorld::ClearForces()
+{
+	std::fill(mForceX.begin(), mForceX.end(), 0.0f);
+	std::fill(mForceY.begin(), mForceY.end(), 0.0f);
+	std::fill(mTorque.begin(), mTorque.end(), 0.0f);
+}
+
+void RigidBodyWorld::CopyBody(int from, int to)
+{
+	mPositionX[to] = mPositionX[from];
+	mPositionY[to] = mPositionY[from];
+	mRotation[to] = mRotation[from];
+	mVelocityX[to] = mVelocityX[from];
+	mVelocityY[to] = mVelocityY[from];
+	mAngularVelocity[to] = mAngularVelocity[from];
+	mForceX[to] = mForceX[from];
+	mForceY[to] = mForceY[from];
+	mTorque[to] = mTorque[from];
+	mInverseMass[to] = mInverseMass[from];
+	mInverseInertia[to] = mInverseInertia[from];
+	mSimulated[to] = mSimulated[from];
+
+	mData[to] = mData[from];
+	mTransforms[to] = mTransforms[from];
+	mOwners[to] = mOwners[from];
+}
+
+void RigidBodyWorld::PopBody()
+{
+	mPositionX.pop_back();
+	mPositionY.pop_back();
+	mRotation.pop_back();
+	mVelocityX.pop_back();
+	mVelocityY.pop_back();
+	mAngularVelocity.pop_back();
+	mForceX.pop_back();
+	mForceY.pop_back();
+	mTorque.pop_back();
+	mInverseMass.pop_back();
+	mInverseInertia.pop_back();
+	mSimulated.pop_back();
+
+	mData.pop_back();
+	mTransforms.pop_back();
+	mOwners.pop_back();
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Consts.h"
+
+class RigidBodyComponent;
+class TransformComponent;
+
+struct RigidBodyIntegrationBenchmark
+{
+	int			bodyCount = 0;
+	int			iterations = 0;
+	float		simdMicroseconds = 0; // Average time for one IntegrateVelocities of every body
+	float		scalarMicroseconds = 0;
+	bool		simdAvailable = false; // False if the build has no SSE2, in which case both times are of the scalar path
+	bool		identical = false; // Both paths left every body with the same state, bit for bit
+};
+
+// Owns the state of every rigidbody in a physics scene. The values the integrator reads and writes every step are stored as
+// separate arrays so they can be processed four bodies at a time. RigidBodyComponents only hold an index into a world.
+class RigidBodyWorld
+{
+public:
+	RigidBodyWorld();
+	~RigidBodyWorld(); // Moves any remaining bodies to the unassigned world so their components stay valid
+
+	RigidBodyWorld(const RigidBodyWorld&) = delete;
+	RigidBodyWorld& operator=(const RigidBodyWorld&) = delete;
+
+	int AddBody(RigidBodyComponent* owner, const RigidBodyData& data); // Adds a body at rest. Returns its index
+	void RemoveBody(int index); // Moves the last body into the gap so the arrays stay packed
+	void TransferBody(int index, RigidBodyWorld& destination); // Moves a body and all of its state into another world
+
+	void SetTransform(int index, TransformComponent* transform) { mTransforms[index] = transform; } // The transform the body moves
+	TransformComponent* GetTransform(int index) { return mTransforms[index]; }
+
+	void ClearSimulated();
+	void SetSimulated(int index) { mSimulated[index] = 0xFFFFFFFF; } // Only simulated bodies are integrated this step
+
+	void ReadTransforms(); // Copies the world position and rotation of every simulated body from its transform
+	void WriteTransforms(); // Copies the integrated position and rotation of every simulated body back to its transform
+
+	void IntegrateForces(float deltaTime); // Half step of force and gravity into velocity
+	void IntegrateVelocities(float deltaTime); // Full step of velocity into position followed by the second half step of forces
+	void ClearForces();
+
+	int GetBodyCount() const { return (int)mOwners.size(); }
+
+	void SetSimdEnabled(bool enabled) { mSimdEnabled = enabled; } // The scalar path gives identical results, so this is only for comparing the two
+
+	// Integrates 'bodyCount' bodies that belong to no scene 'iterations' times with each path. Run the game with -benchmarkphysics
+	static RigidBodyIntegrationBenchmark BenchmarkIntegration(int bodyCount, int iterations);
+
+	// Holds bodies that aren't part of a physics scene, such as ones that have just been created or belong to the editor.
+	// While a scene is being built this is the holding world of that scene instead, so scenes can be built on other threads
+	static RigidBodyWorld& Unassigned();
+	static void SetUnassigned(RigidBodyWorld* world); // For this thread only. Null goes back to the shared world
+
+private:
+	friend class RigidBodyComponent;
+
+	explicit RigidBodyWorld(bool isUnassigned);
+
+	void CopyBody(int from, int to);
+	void PopBody();
+
+	// Hot, read every step
+	std::vector<float>					mPositionX;
+	std::vector<float>					mPositionY;
+	std::vector<float>					mRotation; // RADIANS
+	std::vector<float>					mVelocityX;
+	std::vector<float>					mVelocityY;
+	std::vector<float>					mAngularVelocity;
+	std::vector<float>					mForceX;
+	std::vector<float>					mForceY;
+	std::vector<float>					mTorque;
+	std::vector<float>					mInverseMass;
+	std::vector<float>					mInverseInertia;
+	std::vector<uint32_t>				mSimulated; // All bits set for bodies being integrated so it can be used directly as a SIMD mask
+
+	// Cold
+	std::vector<RigidBodyData>			mData;
+	std::vector<TransformComponent*>	mTransforms;
+	std::vector<RigidBodyComponent*>	mOwners;
+
+	bool								mIsUnassigned;
+	bool								mSimdEnabled = true;
+};
+
+// Makes a world hold the bodies created on this thread until it goes out of scope
+class UnassignedWorldScope
+{
+public:
+	UnassignedWorldScope(RigidBodyWorld& world) : mPrevious(&RigidBodyWorld::Unassigned()) { RigidBodyWorld::SetUnassigned(&world); }
+	~UnassignedWorldScope() { RigidBodyWorld::SetUnassigned(mPrevious); }
+
+private:
+	RigidBodyWorld*			mPrevious;
+};
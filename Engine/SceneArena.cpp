@@ -0,0 +1,148 @@
+#include "SceneArena.h"
+
+#include "EngineLog.h"
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <vector>
+
+static constexpr size_t OBJECT_HEADER_SIZE = 16; // Every object starts with a pointer to the blocks it came from, padded to keep the object aligned
+static constexpr size_t ALIGNMENT = 16;
+
+static thread_local SceneArena* sCurrentArena = nullptr;
+
+// The memory of an arena. Normally freed when the arena is released, but if anything built in the arena is still alive
+// then, the arena lets go of its blocks and they are freed along with the last of those objects
+struct SceneArenaBlocks
+{
+	std::vector<char*>		blocks;
+	std::atomic<int>		liveAllocationCount{ 0 }; // Objects left once the arena has let go can be freed on any thread
+	SceneArenaStats*		stats; // The arena's. Null once it has let go of the blocks
+
+	void FreeBlocks()
+	{
+		for (auto block : blocks)
+			::operator delete(block);
+
+		blocks.clear();
+	}
+};
+
+SceneArena::SceneArena(size_t blockSize) : mBlockSize(blockSize)
+{
+}
+
+SceneArena::~SceneArena()
+{
+	Release();
+}
+
+void * SceneArena::Allocate(size_t size)
+{
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	if (mBlocks == nullptr)
+	{
+		mBlocks = new SceneArenaBlocks();
+		mBlocks->stats = &mStats;
+	}
+
+	if (mCursor == nullptr || size > (size_t)(mBlockEnd - mCursor))
+	{
+		// Anything bigger than a block gets a block of its own
+		size_t blockSize = std::max(size, mBlockSize);
+		char* block = static_cast<char*>(::operator new(blockSize));
+		mBlocks->blocks.push_back(block);
+		mStats.blockCount++;
+
+		mCursor = block;
+		mBlockEnd = block + blockSize;
+	}
+
+	void* memory = mCursor;
+	mCursor += size;
+
+	mBlocks->liveAllocationCount++;
+	mStats.allocationCount++;
+	mStats.liveAllocationCount++;
+	mStats.bytesAllocated += size;
+
+	return memory;
+}
+
+void SceneArena::Release()
+{
+	if (mBlocks == nullptr)
+		return;
+
+	if (mBlocks->liveAllocationCount == 0)
+	{
+		mBlocks->FreeBlocks();
+		delete mBlocks;
+	}
+	else
+	{
+		// Something still holds an object built in the scene, and freeing the blocks now would pull its memory out from under it
+		EngineLog::Write("Scene arena released with " + std::to_string(mStats.liveAllocationCount) + " of " + std::to_string(mStats.allocationCount) +
+			" allocations still alive. Keeping its " + std::to_string(mStats.blockCount) + " blocks until they are freed");
+		assert(!"Scene arena released with objects still alive");
+
+		mBlocks->stats = nullptr;
+	}
+
+	mBlocks = nullptr;
+	mCursor = nullptr;
+	mBlockEnd = nullptr;
+	mStats = SceneArenaStats();
+}
+
+SceneArena * SceneArena::GetCurrent()
+{
+	return sCurrentArena;
+}
+
+void SceneArena::SetCurrent(SceneArena * arena)
+{
+	sCurrentArena = arena;
+}
+
+void * SceneArena::AllocateObject(size_t size)
+{
+	SceneArena* arena = sCurrentArena;
+
+	char* memory;
+	if (arena != nullptr)
+		memory = static_cast<char*>(arena->Allocate(size + OBJECT_HEADER_SIZE));
+	else
+		memory = static_cast<char*>(::operator new(size + OBJECT_HEADER_SIZE));
+
+	*reinterpret_cast<SceneArenaBlocks**>(memory) = arena != nullptr ? arena->mBlocks : nullptr;
+	return memory + OBJECT_HEADER_SIZE;
+}
+
+void SceneArena::FreeObject(void * object)
+{
+	if (object == nullptr)
+		return;
+
+	char* memory = static_cast<char*>(object) - OBJECT_HEADER_SIZE;
+	SceneArenaBlocks* blocks = *reinterpret_cast<SceneArenaBlocks**>(memory);
+
+	if (blocks == nullptr)
+	{
+		::operator delete(memory);
+		return;
+	}
+
+	// The memory itself only comes back when the arena is released
+	int liveAllocationCount = --blocks->liveAllocationCount;
+	if (blocks->stats != nullptr)
+		blocks->stats->liveAllocationCount--;
+
+	if (blocks->stats == nullptr && liveAllocationCount == 0)
+	{
+		blocks->FreeBlocks();
+		delete blocks;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include "Consts.h"
+
+struct SceneArenaStats
+{
+	int			allocationCount = 0; // Every object allocated over the arena's lifetime
+	int			liveAllocationCount = 0; // Objects that haven't been freed yet. Should be 0 by the time the arena is released
+	size_t		bytesAllocated = 0;
+	int			blockCount = 0;
+};
+
+struct SceneArenaBlocks;
+
+// Bump allocator that owns the memory of every GameObject and component built for a scene. Objects are still destroyed one
+// at a time, but their memory stays put until the whole arena is released in one go when the scene is replaced.
+// Not thread safe. An arena, its stats and everything allocated from it belong to one thread at a time: the loader thread while
+// the scene is built, then whichever thread takes or cancels it. SceneLoader's mutex is what hands the scene over between them.
+// Only objects that outlive the arena can be freed from anywhere, so the count of those is kept atomically
+class SceneArena
+{
+public:
+	SceneArena(size_t blockSize = SCENE_ARENA_BLOCK_SIZE);
+	~SceneArena();
+
+	SceneArena(const SceneArena&) = delete;
+	SceneArena& operator=(const SceneArena&) = delete;
+
+	void* Allocate(size_t size); // Always 16 byte aligned
+	void Release(); // Frees every block at once. Blocks that still hold live objects are kept until the last of them is freed
+
+	const SceneArenaStats& GetStats() const { return mStats; }
+
+	static SceneArena* GetCurrent(); // Arena that objects created on this thread are allocated from. Null for the heap
+	static void SetCurrent(SceneArena* arena);
+
+	// Used by the classes that allocate themselves from the current arena. Works whether or not there is one
+	static void* AllocateObject(size_t size);
+	static void FreeObject(void* object);
+
+private:
+	size_t					mBlockSize;
+	SceneArenaBlocks*		mBlocks = nullptr; // Objects point at these rather than the arena, as they can outlive it
+	char*					mCursor = nullptr;
+	char*					mBlockEnd = nullptr;
+
+	SceneArenaStats			mStats;
+};
+
+// Makes an arena current on this thread until it goes out of scope
+class SceneArenaScope
+{
+public:
+	SceneArenaScope(SceneArena& arena) : mPrevious(SceneArena::GetCurrent()) { SceneArena::SetCurrent(&arena); }
+	~SceneArenaScope() { SceneArena::SetCurrent(mPrevious); }
+
+private:
+	SceneArena*				mPrevious;
+};
+
+// Lets containers and allocate_shared put their storage in the current arena
+template<class T>
+struct SceneArenaAllocator
+{
+	typedef T value_type;
+
+	SceneArenaAllocator() { }
+	template<class U> SceneArenaAllocator(const SceneArenaAllocator<U>&) { }
+
+	T* allocate(size_t count) { return static_cast<T*>(SceneArena::AllocateObject(count * sizeof(T))); }
+	void deallocate(T* memory, size_t) { SceneArena::FreeObject(memory); }
+
+	template<class U> bool operator==(const SceneArenaAllocator<U>&) const { return true; }
+	template<class U> bool operator!=(const SceneArenaAllocator<U>&) const { return false; }
+};
@@ -39,7 +39,75 @@ void SceneBuilder::InitaliseGameplayValues(string fileName)
 	AI_LATERAL_MAX_SPEED = (float)atof(valuesNode->first_node("AILateralMaxSpeed")->first_attribute("val")->value());
 }
 
-void SceneBuilder::BuildScene(shared_ptr<IScene> scene, string fileName)
+void SceneBuilder::BuildScene(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress)
+{
+	ReadScene(fileName, [&](const SceneNode& root) { BuildSceneFromNode(scene, root, progress); });
+}
+
+void SceneBuilder::BuildSceneFromXml(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress)
+{
+	ReadSceneFromXml(fileName, [&](const SceneNode& root) { BuildSceneFromNode(scene, root, progress); });
+}
+
+void SceneBuilder::BuildSceneFromBinary(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress)
+{
+	ReadSceneFromBinary(fileName, [&](const SceneNode& root) { BuildSceneFromNode(scene, root, progress); });
+}
+
+void SceneBuilder::BuildSceneFromSnapshot(shared_ptr<IScene> scene, const SceneSnapshot& snapshot, SceneLoadProgress* progress)
+{
+	SceneArenaScope arenaScope(scene->GetArena());
+	UnassignedWorldScope bodyScope(scene->GetUnassignedBodies());
+
+	ObjectManager objectManager = ObjectManager();
+	for (const auto& prefab : snapshot.prefabs)
+		objectManager.AddPrefab(prefab.first, prefab.second);
+
+	scene->SceneData = snapshot.levelData;
+
+	if (progress != nullptr)
+		progress->objectCount = (int)snapshot.objects.size();
+
+	for (const auto& object : snapshot.objects)
+	{
+		if (progress != nullptr && progress->cancelled)
+			return;
+
+		// Only the component factories run. Every attribute was read when the snapshot was captured
+		auto gameObject = objectManager.CreateObject(object.tag, object.instanceID, *object.archetype, scene->GetCamera());
+		scene->CacheComponents(gameObject);
+
+		if (progress != nullptr)
+			progress->objectsBuilt++;
+	}
+}
+
+shared_ptr<const SceneSnapshot> SceneBuilder::CaptureScene(string fileName)
+{
+	shared_ptr<const SceneSnapshot> snapshot;
+	ReadScene(fileName, [&](const SceneNode& root) { snapshot = CaptureSceneFromNode(root); });
+	return snapshot;
+}
+
+void SceneBuilder::ReadScene(string fileName, function<void(const SceneNode&)> read)
+{
+	// Use the compiled scene if there is one that was compiled from the XML as it is now, and it reads back as a valid scene
+	string binaryFileName = SceneCompiler::GetCompiledPath(fileName);
+	if (SceneCompiler::IsUpToDate(fileName, binaryFileName))
+	{
+		MappedFile file;
+		SceneBinaryView view;
+		if (file.Open(binaryFileName) && SceneCompiler::ReadBinary(file.GetData(), file.GetSize(), view))
+		{
+			read(SceneNode(&view, 0));
+			return;
+		}
+	}
+
+	ReadSceneFromXml(fileName, read);
+}
+
+void SceneBuilder::ReadSceneFromXml(string fileName, function<void(const SceneNode&)> read)
 {
 	//Load the file
 	ifstream inFile(fileName);
@@ -66,35 +134,153 @@ void SceneBuilder::BuildScene(shared_ptr<IScene> scene, string fileName)
 	doc.parse<parse_no_data_nodes>(&xmlData[0]);
 
 	//Get the root node
-	xml_node<>* root = doc.first_node();
+	read(SceneNode(doc.first_node()));
+}
+
+void SceneBuilder::ReadSceneFromBinary(string fileName, function<void(const SceneNode&)> read)
+{
+	// Read in place. Nothing is copied out of the file apart from the strings components keep
+	MappedFile file;
+	if (!file.Open(fileName))
+		throw std::exception(("Could not load compiled scene: " + fileName).c_str());
+
+	SceneBinaryView view;
+	if (!SceneCompiler::ReadBinary(file.GetData(), file.GetSize(), view))
+		throw std::exception(("Not a compiled scene of this version: " + fileName).c_str());
+
+	read(SceneNode(&view, 0));
+}
+
+void SceneBuilder::BuildSceneFromNode(shared_ptr<IScene> scene, const SceneNode& root, SceneLoadProgress* progress)
+{
+	// Everything built from here on lives in the scene's arena, so it can all be released at once when the scene is replaced.
+	// Bodies are held by the scene too rather than the shared unassigned world, which may be in use on another thread
+	SceneArenaScope arenaScope(scene->GetArena());
+	UnassignedWorldScope bodyScope(scene->GetUnassignedBodies());
 
 	ObjectManager objectManager = ObjectManager();
 	LevelData levelData = ExtractLevelData(root);
 
 	scene->SceneData = levelData;
 
-	xml_node<>* gameObjectNode = root->first_node("GameObject");
+	// Prefabs are compiled before any object is built, so objects can use them wherever they are in the scene
+	for (SceneNode prefabNode = root.FirstChild("Prefab"); prefabNode; prefabNode = prefabNode.NextSibling("Prefab"))
+		objectManager.AddPrefab(prefabNode);
+
+	SceneNode gameObjectNode = root.FirstChild("GameObject");
+
+	if (progress != nullptr)
+	{
+		int objectCount = 0;
+		for (SceneNode node = gameObjectNode; node; node = node.NextSibling("GameObject"))
+			objectCount++;
+
+		progress->objectCount = objectCount;
+	}
 
 	// Loop through every gameobject in the level
 	while (gameObjectNode)
 	{
+		if (progress != nullptr && progress->cancelled)
+			return;
+
 		// Create an instance of the gameobject listed in the level xml
 		auto gameObject = objectManager.CreateObject(gameObjectNode, scene->GetCamera());
 
 		// Cache it's components so they can be used regularly without having to refetch them 
 		scene->CacheComponents(gameObject);
 
-		gameObjectNode = gameObjectNode->next_sibling("GameObject");
+		if (progress != nullptr)
+			progress->objectsBuilt++;
+
+		gameObjectNode = gameObjectNode.NextSibling("GameObject");
 	}
 }
 
-LevelData SceneBuilder::ExtractLevelData(xml_node<>* node)
+shared_ptr<const SceneSnapshot> SceneBuilder::CaptureSceneFromNode(const SceneNode & root)
+{
+	auto snapshot = make_shared<SceneSnapshot>();
+	snapshot->levelData = ExtractLevelData(root);
+
+	for (SceneNode prefabNode = root.FirstChild("Prefab"); prefabNode; prefabNode = prefabNode.NextSibling("Prefab"))
+	{
+		string name = prefabNode.GetString("name");
+		if (!snapshot->prefabs.insert(make_pair(name, make_shared<PrefabArchetype>(prefabNode))).second)
+			throw std::exception(("The scene has more than one prefab called " + name + ".").c_str());
+	}
+
+	// Each object is compiled the same way a prefab is, so the snapshot reads the scene exactly as ObjectManager::CreateObject does
+	for (SceneNode node = root.FirstChild("GameObject"); node; node = node.NextSibling("GameObject"))
+	{
+		SceneSnapshotObject object;
+
+		if (node.HasAttribute("prefab"))
+		{
+			auto prefab = snapshot->prefabs.find(node.GetString("prefab"));
+			if (prefab == snapshot->prefabs.end())
+				throw std::exception(("The scene has no prefab called " + node.GetString("prefab") + ".").c_str());
+
+			object.tag = node.HasAttribute("tag") ? node.GetString("tag") : prefab->second->GetTag();
+			object.instanceID = node.HasAttribute("instanceid") ? node.GetInt("instanceid") : -1;
+			object.archetype = prefab->second->WithOverrides(node);
+		}
+		else
+		{
+			object.tag = node.GetString("tag");
+			object.instanceID = node.GetInt("instanceid");
+			object.archetype = make_shared<PrefabArchetype>(node);
+		}
+
+		snapshot->objects.push_back(object);
+	}
+
+	return snapshot;
+}
+
+LevelData SceneBuilder::ExtractLevelData(const SceneNode& node)
 {
 	LevelData levelData;
-	levelData.levelLeftBounds = (float)atof(node->first_attribute("leftBound")->value());
-	levelData.levelRightBounds = (float)atof(node->first_attribute("rightBound")->value());
-	levelData.levelBottomBounds = abs((float)atof(node->first_attribute("bottomBound")->value())); // Make negative
-	levelData.levelTopBounds = abs((float)atof(node->first_attribute("topBound")->value()));
+	levelData.levelLeftBounds = node.GetFloat("leftBound");
+	levelData.levelRightBounds = node.GetFloat("rightBound");
+	levelData.levelBottomBounds = abs(node.GetFloat("bottomBound")); // Make negative
+	levelData.levelTopBounds = abs(node.GetFloat("topBound"));
 
 	return levelData;
+}
+
+SceneLoadBenchmark SceneBuilder::BenchmarkSceneLoad(function<shared_ptr<IScene>()> makeScene, string fileName, int iterations)
+{
+	if (iterations <= 0)
+		throw std::exception("A scene load benchmark needs at least one iteration.");
+
+	// Make sure both paths build the same scene
+	string binaryFileName = SceneCompiler::GetCompiledPath(fileName);
+	SceneCompiler::CompileScene(fileName, binaryFileName);
+
+	SceneLoadBenchmark benchmark;
+	benchmark.iterations = iterations;
+
+	// Scenes are destroyed outside of the timed section, as that cost is the same whichever way they were built
+	for (int i = 0; i < iterations; i++)
+	{
+		shared_ptr<IScene> scene = makeScene();
+
+		auto start = chrono::steady_clock::now();
+		BuildSceneFromXml(scene, fileName);
+		benchmark.xmlMilliseconds += chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+	}
+
+	for (int i = 0; i < iterations; i++)
+	{
+		shared_ptr<IScene> scene = makeScene();
+
+		auto start = chrono::steady_clock::now();
+		BuildSceneFromBinary(scene, binaryFileName);
+		benchmark.binaryMilliseconds += chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+	}
+
+	benchmark.xmlMilliseconds /= iterations;
+	benchmark.binaryMilliseconds /= iterations;
+
+	return benchmark;
 }
\ No newline at end of file
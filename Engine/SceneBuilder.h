@@ -1,18 +1,80 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <vector>
+
 #include "IScene.h"
 #include "ObjectManager.h"
+#include "PrefabArchetype.h"
+#include "SceneNode.h"
+#include "SceneCompiler.h"
+#include "MappedFile.h"
 
 #include "rapidxml.hpp"
 
 using namespace rapidxml;
 using namespace std;
 
+struct SceneLoadBenchmark
+{
+	int			iterations = 0;
+	float		xmlMilliseconds = 0; // Average time to build the scene from its XML
+	float		binaryMilliseconds = 0; // Average time to build it from the compiled scene
+};
+
+// Lets another thread watch a scene being built, and stop it early
+struct SceneLoadProgress
+{
+	atomic<int>		objectCount{ 0 }; // GameObjects in the scene. 0 until the file has been read
+	atomic<int>		objectsBuilt{ 0 };
+	atomic<bool>	cancelled{ false }; // Checked between objects. The scene is left half built
+
+	float GetFraction() const
+	{
+		int count = objectCount.load();
+		return count > 0 ? (float)objectsBuilt.load() / count : 0.0f;
+	}
+};
+
+struct SceneSnapshotObject
+{
+	string										tag;
+	int											instanceID; // -1 gets a new one each time the scene is built
+	shared_ptr<const PrefabArchetype>			archetype; // Objects made from a prefab share the compiled components they don't override
+};
+
+// A scene read once and kept in memory with every component compiled, so it can be built again and again without going
+// back to the disk or reading a single attribute. Never changes once captured, so scenes built from it share everything in it
+struct SceneSnapshot
+{
+	LevelData									levelData;
+	map<string, shared_ptr<PrefabArchetype>>	prefabs;
+	vector<SceneSnapshotObject>					objects; // In the order the scene lists them, as objects can refer to earlier ones
+};
+
 namespace SceneBuilder
 {
 	void InitaliseGameplayValues(string fileName);
 
-	void BuildScene(shared_ptr<IScene> scene, string fileName);
+	void BuildScene(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress = nullptr); // Builds from the compiled scene next to the XML if it is up to date, otherwise from the XML
+	void BuildSceneFromXml(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress = nullptr);
+	void BuildSceneFromBinary(shared_ptr<IScene> scene, string fileName, SceneLoadProgress* progress = nullptr);
+	void BuildSceneFromSnapshot(shared_ptr<IScene> scene, const SceneSnapshot& snapshot, SceneLoadProgress* progress = nullptr);
+
+	shared_ptr<const SceneSnapshot> CaptureScene(string fileName); // Reads the scene from the same file BuildScene would. Throws if a component can't be compiled
+
+	// Compiles the scene then builds it from the XML and the compiled scene 'iterations' times each. 'makeScene' makes an empty scene to build into.
+	// Throws if 'iterations' isn't at least 1
+	SceneLoadBenchmark BenchmarkSceneLoad(function<shared_ptr<IScene>()> makeScene, string fileName, int iterations);
+
+	void BuildSceneFromNode(shared_ptr<IScene> scene, const SceneNode& root, SceneLoadProgress* progress = nullptr);
+	shared_ptr<const SceneSnapshot> CaptureSceneFromNode(const SceneNode& root);
 
-	inline LevelData ExtractLevelData(xml_node<>* node);
-}
\ No newline at end of file
+	void ReadScene(string fileName, function<void(const SceneNode&)> read); // Calls 'read' with the root node of the compiled scene if it is up to date, otherwise of the XML
+	void ReadSceneFromXml(string fileName, function<void(const SceneNode&)> read);
+	void ReadSceneFromBinary(string fileName, function<void(const SceneNode&)> read);
+	inline LevelData ExtractLevelData(const SceneNode& node);
+}
@@ -0,0 +1,239 @@
+#include "SceneCompiler.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace
+{
+	// Everything that ends up in the file, built up while walking the XML
+	struct CompiledScene
+	{
+		vector<SceneBinaryNode>				nodes;
+		vector<SceneBinaryAttribute>		attributes;
+		vector<char>						strings;
+		unordered_map<string, uint32_t>		stringOffsets; // Names and values repeat a lot, so each is only stored once
+
+		uint32_t AddString(const char* text)
+		{
+			auto it = stringOffsets.find(text);
+			if (it != stringOffsets.end())
+				return it->second;
+
+			uint32_t offset = (uint32_t)strings.size();
+			strings.insert(strings.end(), text, text + strlen(text) + 1);
+			stringOffsets[text] = offset;
+			return offset;
+		}
+
+		int AddNode(xml_node<>* xmlNode)
+		{
+			int index = (int)nodes.size();
+			nodes.push_back(SceneBinaryNode());
+
+			// Attributes of a node are stored next to each other so looking one up never leaves the node's range
+			uint32_t firstAttribute = (uint32_t)attributes.size();
+			for (xml_attribute<>* xmlAttribute = xmlNode->first_attribute(); xmlAttribute != nullptr; xmlAttribute = xmlAttribute->next_attribute())
+			{
+				SceneBinaryAttribute attribute;
+				attribute.nameHash = HashSceneName(xmlAttribute->name());
+				attribute.name = AddString(xmlAttribute->name());
+				attribute.value = AddString(xmlAttribute->value());
+				attribute.intValue = atoi(xmlAttribute->value());
+				attribute.floatValue = (float)atof(xmlAttribute->value());
+				attributes.push_back(attribute);
+			}
+
+			int firstChild = -1;
+			int previousChild = -1;
+			for (xml_node<>* xmlChild = xmlNode->first_node(); xmlChild != nullptr; xmlChild = xmlChild->next_sibling())
+			{
+				if (xmlChild->type() != node_element)
+					continue;
+
+				int child = AddNode(xmlChild);
+				if (previousChild == -1)
+					firstChild = child;
+				else
+					nodes[previousChild].nextSibling = child;
+
+				previousChild = child;
+			}
+
+			SceneBinaryNode& node = nodes[index];
+			node.nameHash = HashSceneName(xmlNode->name());
+			node.name = AddString(xmlNode->name());
+			node.firstAttribute = firstAttribute;
+			node.attributeCount = (uint32_t)attributes.size() - firstAttribute;
+			node.firstChild = firstChild;
+			node.nextSibling = -1;
+
+			return index;
+		}
+	};
+}
+
+void SceneCompiler::CompileScene(const string & xmlFileName, const string & binaryFileName)
+{
+	ifstream inFile(xmlFileName, ios::binary);
+	if (!inFile)
+		throw std::exception(("Could not load scene: " + xmlFileName).c_str());
+
+	vector<char> xmlData((istreambuf_iterator<char>(inFile)), istreambuf_iterator<char>());
+	xmlData.push_back('\0');
+
+	xml_document<> doc;
+	doc.parse<parse_no_data_nodes>(&xmlData[0]);
+
+	xml_node<>* root = doc.first_node();
+	if (root == nullptr)
+		throw std::exception(("The scene is empty: " + xmlFileName).c_str());
+
+	CompiledScene compiled;
+	compiled.AddNode(root);
+
+	SceneBinaryHeader header;
+	header.magic = SCENE_BINARY_MAGIC;
+	header.version = SCENE_BINARY_VERSION;
+	header.sourceWriteTime = GetFileWriteTime(xmlFileName);
+	header.nodeCount = (uint32_t)compiled.nodes.size();
+	header.attributeCount = (uint32_t)compiled.attributes.size();
+	header.stringBytes = (uint32_t)compiled.strings.size();
+	header.nodeOffset = sizeof(SceneBinaryHeader);
+	header.attributeOffset = header.nodeOffset + header.nodeCount * sizeof(SceneBinaryNode);
+	header.stringOffset = header.attributeOffset + header.attributeCount * sizeof(SceneBinaryAttribute);
+
+	ofstream outFile(binaryFileName, ios::binary | ios::trunc);
+	if (!outFile)
+		throw std::exception(("Could not write compiled scene: " + binaryFileName).c_str());
+
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	outFile.write(reinterpret_cast<const char*>(compiled.nodes.data()), compiled.nodes.size() * sizeof(SceneBinaryNode));
+	outFile.write(reinterpret_cast<const char*>(compiled.attributes.data()), compiled.attributes.size() * sizeof(SceneBinaryAttribute));
+	outFile.write(compiled.strings.data(), compiled.strings.size());
+
+	if (!outFile)
+		throw std::exception(("Could not write compiled scene: " + binaryFileName).c_str());
+}
+
+int SceneCompiler::CompileDirectory(const string & levelsPath)
+{
+	int compiledCount = 0;
+
+	WIN32_FIND_DATAA findData;
+	HANDLE find = FindFirstFileA((levelsPath + "\\*.xml").c_str(), &findData);
+	if (find == INVALID_HANDLE_VALUE)
+		return 0;
+
+	do
+	{
+		string xmlFileName = levelsPath + "\\" + findData.cFileName;
+		CompileScene(xmlFileName, GetCompiledPath(xmlFileName));
+		compiledCount++;
+	} while (FindNextFileA(find, &findData));
+
+	FindClose(find);
+
+	return compiledCount;
+}
+
+string SceneCompiler::GetCompiledPath(const string & xmlFileName)
+{
+	size_t extension = xmlFileName.find_last_of('.');
+	if (extension == string::npos || xmlFileName.find_first_of("\\/", extension) != string::npos)
+		return xmlFileName + SCENE_BINARY_EXTENSION;
+
+	return xmlFileName.substr(0, extension) + SCENE_BINARY_EXTENSION;
+}
+
+bool SceneCompiler::IsUpToDate(const string & xmlFileName, const string & binaryFileName)
+{
+	// Only the header is read, so this costs next to nothing compared to loading either file
+	ifstream binaryFile(binaryFileName, ios::binary);
+	if (!binaryFile)
+		return false;
+
+	SceneBinaryHeader header;
+	if (!binaryFile.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+
+	return header.magic == SCENE_BINARY_MAGIC && header.version == SCENE_BINARY_VERSION
+		&& header.sourceWriteTime == GetFileWriteTime(xmlFileName);
+}
+
+bool SceneCompiler::ReadBinary(const char * data, size_t size, SceneBinaryView & view)
+{
+	if (data == nullptr || size < sizeof(SceneBinaryHeader))
+		return false;
+
+	const SceneBinaryHeader* header = reinterpret_cast<const SceneBinaryHeader*>(data);
+	if (header->magic != SCENE_BINARY_MAGIC || header->version != SCENE_BINARY_VERSION || header->nodeCount == 0)
+		return false;
+
+	if (header->nodeOffset % alignof(SceneBinaryNode) != 0 || header->attributeOffset % alignof(SceneBinaryAttribute) != 0)
+		return false;
+
+	// A truncated file would otherwise be read past its end
+	if ((size_t)header->nodeOffset + (size_t)header->nodeCount * sizeof(SceneBinaryNode) > size
+		|| (size_t)header->attributeOffset + (size_t)header->attributeCount * sizeof(SceneBinaryAttribute) > size
+		|| (size_t)header->stringOffset + header->stringBytes > size)
+	{
+		return false;
+	}
+
+	const SceneBinaryNode* nodes = reinterpret_cast<const SceneBinaryNode*>(data + header->nodeOffset);
+	const SceneBinaryAttribute* attributes = reinterpret_cast<const SceneBinaryAttribute*>(data + header->attributeOffset);
+	const char* strings = data + header->stringOffset;
+
+	// SceneNode follows every index and offset without checking, so they are all checked once here. A file that only looks
+	// up to date, or has been corrupted, is turned down rather than read out of bounds
+	if (header->stringBytes == 0 || strings[header->stringBytes - 1] != '\0')
+		return false;
+
+	for (uint32_t i = 0; i < header->nodeCount; i++)
+	{
+		const SceneBinaryNode& node = nodes[i];
+
+		// Nodes are written parent first and in document order, so links only ever point forwards. That also rules out loops
+		if ((node.firstChild != -1 && (node.firstChild <= (int32_t)i || (uint32_t)node.firstChild >= header->nodeCount))
+			|| (node.nextSibling != -1 && (node.nextSibling <= (int32_t)i || (uint32_t)node.nextSibling >= header->nodeCount))
+			|| (uint64_t)node.firstAttribute + node.attributeCount > header->attributeCount
+			|| node.name >= header->stringBytes)
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < header->attributeCount; i++)
+	{
+		if (attributes[i].name >= header->stringBytes || attributes[i].value >= header->stringBytes)
+			return false;
+	}
+
+	view.header = header;
+	view.nodes = nodes;
+	view.attributes = attributes;
+	view.strings = strings;
+
+	return true;
+}
+
+uint64_t SceneCompiler::GetFileWriteTime(const string & fileName)
+{
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return 0;
+
+	FILETIME writeTime;
+	uint64_t time = 0;
+	if (GetFileTime(file, nullptr, nullptr, &writeTime))
+		time = ((uint64_t)writeTime.dwHighDateTime << 32) | writeTime.dwLowDateTime;
+
+	CloseHandle(file);
+
+	return time;
+}
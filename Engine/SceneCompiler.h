@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "SceneFormat.h"
+#include "SceneNode.h"
+
+using namespace std;
+
+// Turns scene XML into the binary format in SceneFormat.h, ahead of time, so loading a scene never has to parse text.
+// Run the game with -compilescenes to compile every scene in the Levels folder.
+namespace SceneCompiler
+{
+	void CompileScene(const string& xmlFileName, const string& binaryFileName); // Throws if the XML can't be read or the binary can't be written
+	int CompileDirectory(const string& levelsPath); // Compiles every .xml file in the folder. Returns how many were compiled
+
+	string GetCompiledPath(const string& xmlFileName); // The .scene file that sits next to the XML
+	bool IsUpToDate(const string& xmlFileName, const string& binaryFileName); // True if the binary exists, is this version and was compiled from the XML as it is now
+
+	bool ReadBinary(const char* data, size_t size, SceneBinaryView& view); // Checks the header and every index and offset, then fills in the view. False if the data isn't a valid scene of this version
+	uint64_t GetFileWriteTime(const string& fileName); // 0 if the file doesn't exist
+}
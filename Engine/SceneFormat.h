@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+// Layout of a compiled scene. SceneCompiler writes it and SceneNode reads it in place, straight out of a memory-mapped file.
+// Every node and attribute of the scene's XML is kept, but names are hashed and numbers are parsed once when compiling.
+static constexpr uint32_t SCENE_BINARY_MAGIC = 0x4E435342; // "BSCN"
+static constexpr uint32_t SCENE_BINARY_VERSION = 1; // Bump whenever the layout changes. Files from other versions are compiled again
+static constexpr const char* SCENE_BINARY_EXTENSION = ".scene";
+
+struct SceneBinaryHeader
+{
+	uint32_t	magic;
+	uint32_t	version;
+	uint64_t	sourceWriteTime; // Last write time of the XML the scene was compiled from, so stale files can be spotted
+	uint32_t	nodeCount;
+	uint32_t	attributeCount;
+	uint32_t	stringBytes;
+	uint32_t	nodeOffset; // Byte offsets from the start of the file
+	uint32_t	attributeOffset;
+	uint32_t	stringOffset;
+};
+
+// Node 0 is the XML's root node. Children of a node are linked through nextSibling in document order
+struct SceneBinaryNode
+{
+	uint32_t	nameHash;
+	uint32_t	name; // Offset into the string table
+	uint32_t	firstAttribute;
+	uint32_t	attributeCount;
+	int32_t		firstChild; // -1 if there isn't one
+	int32_t		nextSibling;
+};
+
+struct SceneBinaryAttribute
+{
+	uint32_t	nameHash;
+	uint32_t	name; // Offset into the string table
+	uint32_t	value;
+	int32_t		intValue; // Value as atoi would read it
+	float		floatValue; // Value as atof would read it
+};
+
+// Pointers into a loaded scene file. Only valid while the file is mapped
+struct SceneBinaryView
+{
+	const SceneBinaryHeader*		header = nullptr;
+	const SceneBinaryNode*			nodes = nullptr;
+	const SceneBinaryAttribute*		attributes = nullptr;
+	const char*						strings = nullptr;
+};
+
+// FNV-1a. Used for node and attribute names
+inline uint32_t HashSceneName(const char* name)
+{
+	uint32_t hash = 2166136261u;
+	for (; *name != '\0'; name++)
+	{
+		hash ^= (unsigned char)*name;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
@@ -0,0 +1,134 @@
+#include "SceneLoader.h"
+
+SceneLoader::SceneLoader()
+{
+	mThread = std::thread(&SceneLoader::LoaderLoop, this);
+}
+
+SceneLoader::~SceneLoader()
+{
+	Cancel();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mShutdown = true;
+	}
+
+	mStateChanged.notify_all();
+	mThread.join();
+}
+
+void SceneLoader::Load(shared_ptr<IScene> scene, const string & fileName)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mState != eSceneLoadIdle)
+			throw std::exception("A scene is already being loaded.");
+
+		mScene = scene;
+		mFileName = fileName;
+		mError = nullptr;
+		mProgress.objectCount = 0;
+		mProgress.objectsBuilt = 0;
+		mProgress.cancelled = false;
+		mState = eSceneLoadBuilding;
+	}
+
+	mStateChanged.notify_all();
+}
+
+void SceneLoader::Cancel()
+{
+	shared_ptr<IScene> discarded;
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (mState == eSceneLoadBuilding)
+		{
+			mProgress.cancelled = true;
+			mStateChanged.wait(lock, [this] { return mState != eSceneLoadBuilding; });
+		}
+
+		discarded = move(mScene);
+		mError = nullptr;
+		mState = eSceneLoadIdle;
+	}
+
+	// Destroyed outside the lock as it can take a while. The loader has finished with it
+	discarded = nullptr;
+}
+
+bool SceneLoader::IsLoading() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mState != eSceneLoadIdle;
+}
+
+bool SceneLoader::IsReady() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mState == eSceneLoadReady;
+}
+
+shared_ptr<IScene> SceneLoader::TakeScene()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mState != eSceneLoadReady)
+		return nullptr;
+
+	mState = eSceneLoadIdle;
+
+	shared_ptr<IScene> scene = move(mScene);
+
+	if (mError)
+	{
+		// The half built scene goes with it
+		std::exception_ptr error = mError;
+		mError = nullptr;
+		scene = nullptr;
+		std::rethrow_exception(error);
+	}
+
+	return scene;
+}
+
+void SceneLoader::LoaderLoop()
+{
+	while (true)
+	{
+		shared_ptr<IScene> scene;
+		string fileName;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mStateChanged.wait(lock, [this] { return mShutdown || mState == eSceneLoadBuilding; });
+
+			if (mShutdown)
+				return;
+
+			scene = mScene;
+			fileName = mFileName;
+		}
+
+		std::exception_ptr error;
+		try
+		{
+			SceneBuilder::BuildScene(scene, fileName, &mProgress);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		// Let go before anyone is told, so the scene is always destroyed on the thread that takes or cancels it
+		scene = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mError = mProgress.cancelled ? nullptr : error;
+			mState = eSceneLoadReady;
+		}
+
+		mStateChanged.notify_all();
+	}
+}
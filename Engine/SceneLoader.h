@@ -0,0 +1,51 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "SceneBuilder.h"
+
+enum SceneLoadState
+{
+	eSceneLoadIdle,
+	eSceneLoadBuilding,
+	eSceneLoadReady // Built, or failed, and waiting for TakeScene
+};
+
+// Builds scenes on a thread of its own so the game keeps drawing while a level loads. A built scene is only handed over
+// through TakeScene, which the engine calls between frames, so the scene being replaced is never swapped out part way through one.
+// The thread lives as long as the loader and sleeps while there is nothing to build
+class SceneLoader
+{
+public:
+	SceneLoader();
+	~SceneLoader(); // Cancels any load and joins the thread
+
+	SceneLoader(const SceneLoader&) = delete;
+	SceneLoader& operator=(const SceneLoader&) = delete;
+
+	void Load(shared_ptr<IScene> scene, const string& fileName); // Starts building 'fileName' into the empty 'scene'. Throws if a load hasn't been taken or cancelled yet
+	void Cancel(); // Blocks until the loader has stopped building, then throws away the scene
+
+	bool IsLoading() const; // True from Load until the scene is taken or cancelled
+	bool IsReady() const;
+	float GetProgress() const { return mProgress.GetFraction(); } // 0 to 1
+
+	shared_ptr<IScene> TakeScene(); // Null if nothing is ready. Rethrows whatever the build threw if it failed
+
+private:
+	void LoaderLoop();
+
+	std::thread								mThread;
+	mutable std::mutex						mMutex;
+	std::condition_variable					mStateChanged;
+	bool									mShutdown = false;
+
+	SceneLoadState							mState = eSceneLoadIdle;
+	shared_ptr<IScene>						mScene; // Only touched by the loader thread while building
+	string									mFileName;
+	std::exception_ptr						mError;
+	SceneLoadProgress						mProgress;
+};
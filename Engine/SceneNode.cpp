@@ -0,0 +1,124 @@
+#include "SceneNode.h"
+
+#include <cstring>
+
+bool SceneNode::HasAttribute(const char * name) const
+{
+	if (mXmlNode != nullptr)
+		return mXmlNode->first_attribute(name) != nullptr;
+
+	return FindBinaryAttribute(name) != nullptr;
+}
+
+string SceneNode::GetString(const char * name) const
+{
+	return string(GetValue(name));
+}
+
+int SceneNode::GetInt(const char * name) const
+{
+	if (mXmlNode != nullptr)
+		return atoi(GetValue(name));
+
+	const SceneBinaryAttribute* attribute = FindBinaryAttribute(name);
+	if (attribute == nullptr)
+		throw std::exception(("The scene is missing the attribute " + string(name) + ".").c_str());
+
+	return attribute->intValue;
+}
+
+float SceneNode::GetFloat(const char * name) const
+{
+	if (mXmlNode != nullptr)
+		return (float)atof(GetValue(name));
+
+	const SceneBinaryAttribute* attribute = FindBinaryAttribute(name);
+	if (attribute == nullptr)
+		throw std::exception(("The scene is missing the attribute " + string(name) + ".").c_str());
+
+	return attribute->floatValue;
+}
+
+bool SceneNode::GetBool(const char * name) const
+{
+	return strcmp(GetValue(name), "true") == 0;
+}
+
+SceneNode SceneNode::FirstChild(const char * name) const
+{
+	if (mXmlNode != nullptr)
+	{
+		xml_node<>* child = mXmlNode->first_node(name);
+		return child != nullptr ? SceneNode(child) : SceneNode();
+	}
+
+	if (mBinaryIndex == -1)
+		return SceneNode();
+
+	return FindBinarySibling(mBinary->nodes[mBinaryIndex].firstChild, name);
+}
+
+SceneNode SceneNode::NextSibling(const char * name) const
+{
+	if (mXmlNode != nullptr)
+	{
+		xml_node<>* sibling = mXmlNode->next_sibling(name);
+		return sibling != nullptr ? SceneNode(sibling) : SceneNode();
+	}
+
+	if (mBinaryIndex == -1)
+		return SceneNode();
+
+	return FindBinarySibling(mBinary->nodes[mBinaryIndex].nextSibling, name);
+}
+
+const char * SceneNode::GetValue(const char * name) const
+{
+	if (mXmlNode != nullptr)
+	{
+		xml_attribute<>* attribute = mXmlNode->first_attribute(name);
+		if (attribute != nullptr)
+			return attribute->value();
+	}
+	else
+	{
+		const SceneBinaryAttribute* attribute = FindBinaryAttribute(name);
+		if (attribute != nullptr)
+			return mBinary->strings + attribute->value;
+	}
+
+	throw std::exception(("The scene is missing the attribute " + string(name) + ".").c_str());
+}
+
+const SceneBinaryAttribute * SceneNode::FindBinaryAttribute(const char * name) const
+{
+	if (mBinaryIndex == -1)
+		return nullptr;
+
+	// Nodes only have a handful of attributes, so a scan comparing hashes beats anything cleverer
+	uint32_t hash = HashSceneName(name);
+	const SceneBinaryNode& node = mBinary->nodes[mBinaryIndex];
+	for (uint32_t i = node.firstAttribute; i < node.firstAttribute + node.attributeCount; i++)
+	{
+		const SceneBinaryAttribute& attribute = mBinary->attributes[i];
+		if (attribute.nameHash == hash && strcmp(mBinary->strings + attribute.name, name) == 0)
+			return &attribute;
+	}
+
+	return nullptr;
+}
+
+SceneNode SceneNode::FindBinarySibling(int index, const char * name) const
+{
+	uint32_t hash = HashSceneName(name);
+	while (index != -1)
+	{
+		const SceneBinaryNode& node = mBinary->nodes[index];
+		if (node.nameHash == hash && strcmp(mBinary->strings + node.name, name) == 0)
+			return SceneNode(mBinary, index);
+
+		index = node.nextSibling;
+	}
+
+	return SceneNode();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Consts.h"
+#include "SceneFormat.h"
+
+#include "rapidxml.hpp"
+
+using namespace rapidxml;
+using namespace std;
+
+// One attribute of a node, as SceneNode::ForEachAttribute hands them out. Numbers are only parsed when asked for
+struct SceneAttribute
+{
+	uint32_t						nameHash; // HashSceneName of the name
+	const char*						name;
+	const char*						value;
+	const SceneBinaryAttribute*		binary; // Null for XML
+
+	int GetInt() const { return binary != nullptr ? binary->intValue : atoi(value); }
+	float GetFloat() const { return binary != nullptr ? binary->floatValue : (float)atof(value); }
+	bool GetBool() const { return strcmp(value, "true") == 0; }
+};
+
+// One node of a scene description, read either from parsed XML or in place from a compiled scene.
+// Lets the scene builder read both with the same code. Cheap to copy, and only valid while the document it came from is
+class SceneNode
+{
+public:
+	SceneNode() { }
+	explicit SceneNode(xml_node<>* node) : mXmlNode(node) { }
+	SceneNode(const SceneBinaryView* binary, int index) : mBinary(binary), mBinaryIndex(index) { }
+
+	explicit operator bool() const { return mXmlNode != nullptr || mBinaryIndex != -1; }
+
+	bool HasAttribute(const char* name) const;
+	string GetString(const char* name) const; // Every getter throws if the attribute is missing
+	int GetInt(const char* name) const;
+	float GetFloat(const char* name) const;
+	bool GetBool(const char* name) const; // True if the attribute is "true"
+	const char* GetValue(const char* name) const; // Points into the document rather than copying. Throws if the attribute is missing
+
+	template<class Func>
+	void ForEachAttribute(Func func) const; // Calls func(const SceneAttribute&) for each attribute in document order
+
+	SceneNode FirstChild(const char* name) const; // Null node if there isn't one
+	SceneNode NextSibling(const char* name) const;
+
+private:
+	const SceneBinaryAttribute* FindBinaryAttribute(const char* name) const;
+	SceneNode FindBinarySibling(int index, const char* name) const; // First node from 'index' onwards, along the sibling links, called 'name'
+
+	xml_node<>*						mXmlNode = nullptr;
+	const SceneBinaryView*			mBinary = nullptr;
+	int								mBinaryIndex = -1;
+};
+
+template<class Func>
+inline void SceneNode::ForEachAttribute(Func func) const
+{
+	if (mXmlNode != nullptr)
+	{
+		for (xml_attribute<>* xmlAttribute = mXmlNode->first_attribute(); xmlAttribute != nullptr; xmlAttribute = xmlAttribute->next_attribute())
+			func(SceneAttribute{ HashSceneName(xmlAttribute->name()), xmlAttribute->name(), xmlAttribute->value(), nullptr });
+
+		return;
+	}
+
+	if (mBinaryIndex == -1)
+		return;
+
+	const SceneBinaryNode& node = mBinary->nodes[mBinaryIndex];
+	for (uint32_t i = node.firstAttribute; i < node.firstAttribute + node.attributeCount; i++)
+	{
+		const SceneBinaryAttribute& attribute = mBinary->attributes[i];
+		func(SceneAttribute{ attribute.nameHash, mBinary->strings + attribute.name, mBinary->strings + attribute.value, &attribute });
+	}
+}
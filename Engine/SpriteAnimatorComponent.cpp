@@ -1,4 +1,5 @@
 #include "SpriteAnimatorComponent.h"
+#include "MessageBus.h"
 
 
 SpriteAnimatorComponent::SpriteAnimatorComponent(int renderLayer)
@@ -20,18 +21,18 @@ void SpriteAnimatorComponent::Draw(ICamera* cam)
 	float halfSpriteWidth = (mSpriteWidth / 2) * trans->GetWorldScale();
 	float halfSpriteHeight = (mSpriteHeight / 2) * trans->GetWorldScale();
 
-	Vec2 pos = trans->GetWorldPosition();
+	Vec2 pos = trans->GetRenderPosition();
 	float newPosX = pos.x
-		- halfSpriteWidth * cos(trans->GetWorldRotation())
-		+ halfSpriteHeight * sin(trans->GetWorldRotation());
+		- halfSpriteWidth * cos(trans->GetRenderRotation())
+		+ halfSpriteHeight * sin(trans->GetRenderRotation());
 
 	float newPosY = pos.y
-		- halfSpriteHeight * cos(trans->GetWorldRotation())
-		- halfSpriteWidth * sin(trans->GetWorldRotation());
+		- halfSpriteHeight * cos(trans->GetRenderRotation())
+		- halfSpriteWidth * sin(trans->GetRenderRotation());
 
 	cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(newPosX, newPosY), 
 		mAnimations[(int)mSequenceIndex].AnimationFrames[mAnimations[(int)mSequenceIndex].CurrentFrame], 
-		GetTransform()->GetWorldRotation(), GetTransform()->GetWorldScale(), Vec2(0,0));
+		GetTransform()->GetRenderRotation(), GetTransform()->GetWorldScale(), Vec2(0,0));
 }
 
 void SpriteAnimatorComponent::Update(float deltaTime)
@@ -50,6 +51,11 @@ void SpriteAnimatorComponent::RecieveMessage(IMessage & message)
 	}
 }
 
+void SpriteAnimatorComponent::SubscribeToMessages(MessageBus & bus, GameObject * owner)
+{
+	bus.Subscribe(MessageType::eUpdateAnimationSequence, owner, this, this);
+}
+
 void SpriteAnimatorComponent::SetAnimations(int currentAnim, std::vector<AnimationDesc> animDescs)
 {
 	mSequenceIndex = currentAnim;
@@ -61,7 +61,10 @@ public:
 
 	virtual void Draw(ICamera* cam) override;
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderAnimation; }
+	virtual UpdateThreading GetUpdateThreading() override { return eUpdateParallel; }
 	virtual void RecieveMessage(IMessage& message) override;
+	virtual void SubscribeToMessages(MessageBus& bus, GameObject* owner) override;
 
 	void SetFilename(std::string fileName) { mSpriteFileName = fileName; }
 	void SetAnimations(int currentAnim, std::vector<AnimationDesc> animDescs);
@@ -17,14 +17,14 @@ void SpriteRendererComponent::Draw(ICamera* cam)
 	float halfSpriteWidth = (mSpriteWidth / 2) * trans->GetWorldScale();
 	float halfSpriteHeight = (mSpriteHeight / 2) * trans->GetWorldScale();
 
-	Vec2 pos = trans->GetWorldPosition();
+	Vec2 pos = trans->GetRenderPosition();
 	float newPosX = pos.x
-		- halfSpriteWidth * cos(trans->GetWorldRotation())
-		+ halfSpriteHeight * sin(trans->GetWorldRotation());
+		- halfSpriteWidth * cos(trans->GetRenderRotation())
+		+ halfSpriteHeight * sin(trans->GetRenderRotation());
 
 	float newPosY = pos.y
-		- halfSpriteHeight * cos(trans->GetWorldRotation())
-		- halfSpriteWidth * sin(trans->GetWorldRotation());
+		- halfSpriteHeight * cos(trans->GetRenderRotation())
+		- halfSpriteWidth * sin(trans->GetRenderRotation());
 
-	cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(newPosX, newPosY), nullptr, trans->GetWorldRotation(), trans->GetWorldScale(), mOffset);
+	cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(newPosX, newPosY), nullptr, trans->GetRenderRotation(), trans->GetWorldScale(), mOffset);
 }
@@ -0,0 +1,90 @@
+#include "StaticAABBTree.h"
+
+void StaticAABBTree::Build(const std::vector<AABB>& bounds, const std::vector<int>& elements)
+{
+	assert(bounds.size() == elements.size());
+
+	Clear();
+
+	if (bounds.empty())
+		return;
+
+	mBuildItems.resize(bounds.size());
+	for (int i = 0; i < bounds.size(); i++)
+	{
+		mBuildItems[i].aabb = bounds[i];
+		mBuildItems[i].centre = (bounds[i].lowerBound + bounds[i].upperBound) * 0.5f;
+		mBuildItems[i].element = elements[i];
+	}
+
+	// A binary tree with one element per leaf always has 2n - 1 nodes
+	mNodes.reserve(bounds.size() * 2 - 1);
+	BuildRange(0, (int)mBuildItems.size());
+
+	mElementCount = (int)bounds.size();
+	mBuildItems.clear();
+	mBuildItems.shrink_to_fit();
+}
+
+void StaticAABBTree::Clear()
+{
+	mNodes.clear();
+	mElementCount = 0;
+}
+
+void StaticAABBTree::Query(const AABB & aabb, std::vector<int>& elements) const
+{
+	int index = 0;
+	while (index < (int)mNodes.size())
+	{
+		const StaticTreeNode& node = mNodes[index];
+
+		if (!node.aabb.Overlaps(aabb))
+		{
+			index = node.skip; // Nothing below this node can overlap either
+			continue;
+		}
+
+		if (node.element != -1)
+			elements.push_back(node.element);
+
+		index++;
+	}
+}
+
+void StaticAABBTree::BuildRange(int begin, int end)
+{
+	int nodeIndex = (int)mNodes.size();
+	mNodes.push_back(StaticTreeNode());
+
+	AABB aabb = mBuildItems[begin].aabb;
+	AABB centres(mBuildItems[begin].centre, mBuildItems[begin].centre);
+	for (int i = begin + 1; i < end; i++)
+	{
+		aabb = Combine(aabb, mBuildItems[i].aabb);
+		centres = Combine(centres, AABB(mBuildItems[i].centre, mBuildItems[i].centre));
+	}
+
+	mNodes[nodeIndex].aabb = aabb;
+
+	if (end - begin == 1)
+	{
+		mNodes[nodeIndex].element = mBuildItems[begin].element;
+		mNodes[nodeIndex].skip = nodeIndex + 1;
+		return;
+	}
+
+	mNodes[nodeIndex].element = -1;
+
+	// Split at the median centre along the axis the centres are most spread out on
+	bool splitX = centres.upperBound.x - centres.lowerBound.x >= centres.upperBound.y - centres.lowerBound.y;
+	int middle = begin + (end - begin) / 2;
+
+	std::nth_element(mBuildItems.begin() + begin, mBuildItems.begin() + middle, mBuildItems.begin() + end,
+		[splitX](const BuildItem& a, const BuildItem& b) { return splitX ? a.centre.x < b.centre.x : a.centre.y < b.centre.y; });
+
+	BuildRange(begin, middle);
+	BuildRange(middle, end);
+
+	mNodes[nodeIndex].skip = (int)mNodes.size();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "Consts.h"
+
+struct StaticTreeNode
+{
+	AABB aabb; // Exact bounds. Nothing in the tree moves so they don't need fattening
+	int element; // Stores the index to the element. -1 for branches
+	int skip; // Index of the first node after this node's sub tree. Nodes are stored depth first so a branch's first child is always next
+};
+
+// Bounding volume hierarchy for colliders that never move. Built once, top down, into a flat depth first array that can be
+// walked without a stack. Anything that needs to move, or be added one at a time, belongs in a DynamicAABBTree instead.
+class StaticAABBTree
+{
+public:
+	void Build(const std::vector<AABB>& bounds, const std::vector<int>& elements); // Replaces the contents of the tree
+	void Clear();
+
+	void Query(const AABB& aabb, std::vector<int>& elements) const; // Appends every element whose bounds overlap 'aabb'
+
+	int GetElementCount() const { return mElementCount; }
+
+private:
+	struct BuildItem
+	{
+		AABB aabb;
+		Vec2 centre;
+		int element;
+	};
+
+	void BuildRange(int begin, int end); // Adds the sub tree for mBuildItems[begin, end)
+
+	std::vector<StaticTreeNode>		mNodes;
+	std::vector<BuildItem>			mBuildItems; // Only used during Build
+	int								mElementCount = 0;
+};
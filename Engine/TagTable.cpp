@@ -0,0 +1,41 @@
+#include "TagTable.h"
+
+TagTable::TagTable()
+{
+}
+
+TagID TagTable::Intern(const std::string & tag)
+{
+	if (tag.empty())
+		return NO_TAG;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it = mIDs.find(tag);
+	if (it != mIDs.end())
+		return it->second;
+
+	TagID id = (TagID)mNames.size();
+	mNames.push_back(tag);
+	mIDs.insert(std::make_pair(tag, id));
+
+	return id;
+}
+
+const std::string & TagTable::GetName(TagID id)
+{
+	static const std::string noTag;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (id < 0 || id >= mNames.size())
+		return noTag;
+
+	return mNames[id];
+}
+
+int TagTable::GetCount()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return (int)mNames.size();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+typedef int TagID;
+static constexpr TagID NO_TAG = -1; // Matches every tag where a TagID is used as a filter
+
+// Interns tag strings so objects can be compared by tag with a single integer comparison.
+// Tags are interned when objects are loaded, so nothing compares strings while the game is running
+class TagTable
+{
+public:
+	static TagTable& Instance()
+	{
+		static TagTable Instance;
+		return Instance;
+	}
+
+	TagID Intern(const std::string& tag); // Gets the ID of a tag, adding it if it hasn't been seen before. An empty tag is NO_TAG
+	const std::string& GetName(TagID id); // Gets the tag an ID was interned from
+
+	int GetCount();
+
+private:
+	TagTable();
+
+	// Scenes can be loaded on another thread, so interning is locked. IDs never change once given out
+	std::mutex								mMutex;
+	std::unordered_map<std::string, TagID>	mIDs;
+	std::deque<std::string>					mNames; // A deque so the names GetName returns never move
+};
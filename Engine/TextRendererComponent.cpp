@@ -19,5 +19,5 @@ void TextRendererComponent::Draw(ICamera* cam)
 	rgb[0] = colour.f[0];
 	rgb[1] = colour.f[1];
 	rgb[2] = colour.f[2];
-	cam->DrawTextWorldSpace(mText, GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation(), rgb, GetTransform()->GetWorldScale(), mOffset);
+	cam->DrawTextWorldSpace(mText, GetTransform()->GetRenderPosition(), GetTransform()->GetRenderRotation(), rgb, GetTransform()->GetWorldScale(), mOffset);
 }
@@ -26,15 +26,15 @@ void TiledBGRenderer::Draw(ICamera * cam)
 	// Find the closest X centre
 	while (true)
 	{
-		if (mFocusTrans->GetWorldPosition().x > 0)
-			centreTileXPos = GetTransform()->GetWorldPosition().x + (mSpriteWidth * count);
+		if (mFocusTrans->GetRenderPosition().x > 0)
+			centreTileXPos = GetTransform()->GetRenderPosition().x + (mSpriteWidth * count);
 		else
-			centreTileXPos = GetTransform()->GetWorldPosition().x - (mSpriteWidth * count);
-		xDiffNew = std::abs(centreTileXPos - mFocusTrans->GetWorldPosition().x);
+			centreTileXPos = GetTransform()->GetRenderPosition().x - (mSpriteWidth * count);
+		xDiffNew = std::abs(centreTileXPos - mFocusTrans->GetRenderPosition().x);
 
 		if (xDiffNew > xDiffOld)
 		{
-			if (mFocusTrans->GetWorldPosition().x > 0)
+			if (mFocusTrans->GetRenderPosition().x > 0)
 				centreTileXPos -= mSpriteWidth/2;
 			else
 				centreTileXPos += mSpriteWidth/2;
@@ -55,15 +55,15 @@ void TiledBGRenderer::Draw(ICamera * cam)
 	// Find the closest Y centre
 	while (true)
 	{
-		if (mFocusTrans->GetWorldPosition().y > 0)
-			centreTileYPos = GetTransform()->GetWorldPosition().y + (mSpriteHeight * count);
+		if (mFocusTrans->GetRenderPosition().y > 0)
+			centreTileYPos = GetTransform()->GetRenderPosition().y + (mSpriteHeight * count);
 		else
-			centreTileYPos = GetTransform()->GetWorldPosition().y - (mSpriteHeight * count);
-		yDiffNew = std::abs(centreTileYPos - mFocusTrans->GetWorldPosition().y);
+			centreTileYPos = GetTransform()->GetRenderPosition().y - (mSpriteHeight * count);
+		yDiffNew = std::abs(centreTileYPos - mFocusTrans->GetRenderPosition().y);
 
 		if (yDiffNew > yDiffOld)
 		{
-			if (mFocusTrans->GetWorldPosition().y > 0)
+			if (mFocusTrans->GetRenderPosition().y > 0)
 				centreTileYPos -= mSpriteHeight / 2;
 			else
 				centreTileYPos += mSpriteHeight / 2;
@@ -81,16 +81,16 @@ void TiledBGRenderer::Draw(ICamera * cam)
 		case TiledBGDirection::eHorizontal:
 			for (int i = -2; i < 3; i++)
 			{
-				cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(centreTileXPos + (i * mSpriteWidth), GetTransform()->GetWorldPosition().y), 
-					nullptr, GetTransform()->GetWorldRotation(), GetTransform()->GetWorldScale(), Vec2(0,0));
+				cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(centreTileXPos + (i * mSpriteWidth), GetTransform()->GetRenderPosition().y), 
+					nullptr, GetTransform()->GetRenderRotation(), GetTransform()->GetWorldScale(), Vec2(0,0));
 			}
 			break;
 
 		case TiledBGDirection::eVertical:
 			for (int i = -2; i < 3; i++)
 			{
-				cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(GetTransform()->GetWorldPosition().x, centreTileYPos + (i * mSpriteHeight)), 
-					nullptr, GetTransform()->GetWorldRotation(), GetTransform()->GetWorldScale(), Vec2(0, 0));
+				cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(GetTransform()->GetRenderPosition().x, centreTileYPos + (i * mSpriteHeight)), 
+					nullptr, GetTransform()->GetRenderRotation(), GetTransform()->GetWorldScale(), Vec2(0, 0));
 			}
 			break;
 
@@ -101,7 +101,7 @@ void TiledBGRenderer::Draw(ICamera * cam)
 				for (int j = -2; j < 3; j++)
 				{
 					cam->DrawSpriteWorldSpace(mSpriteFileName, Vec2(centreTileXPos + (i * mSpriteWidth), centreTileYPos + (j * mSpriteHeight)), 
-						nullptr, GetTransform()->GetWorldRotation(), GetTransform()->GetWorldScale(), Vec2(0, 0));
+						nullptr, GetTransform()->GetRenderRotation(), GetTransform()->GetWorldScale(), Vec2(0, 0));
 				}
 			}
 			break;
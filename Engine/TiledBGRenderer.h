@@ -15,6 +15,8 @@ public:
 
 	virtual void Draw(ICamera* cam) override;
 	virtual void Update(float deltaTime) override;
+	virtual UpdateOrder GetUpdateOrder() override { return eUpdateOrderAnimation; }
+	virtual UpdateThreading GetUpdateThreading() override { return eUpdateParallelAfterPhysics; } // Follows a transform that physics moves
 
 	void SetFocusTrans(TransformComponent* focTrans) { mFocusTrans = focTrans; mPrevFocusPos = mFocusTrans->GetWorldPosition(); }
 	void SetSprite(std::string sName, float sWidth, float sHeight) { mSpriteFileName = sName; mSpriteWidth = sWidth; mSpriteHeight = sHeight; }
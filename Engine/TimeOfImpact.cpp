@@ -0,0 +1,71 @@
+#include "TimeOfImpact.h"
+
+#include "CircleColliderComponent.h"
+#include "PolygonColliderComponent.h"
+
+static constexpr int MAX_TOI_ITERATIONS = 20;
+
+float DistanceToCollider(const Vec2 & point, ColliderComponent * collider)
+{
+	if (collider->GetType() == ColliderType::eCircle)
+	{
+		CircleColliderComponent* circle = static_cast<CircleColliderComponent*>(collider);
+		return (point - circle->GetTransformComponent()->GetWorldPosition()).Len() - circle->GetRadius();
+	}
+
+	PolygonColliderComponent* polygon = static_cast<PolygonColliderComponent*>(collider);
+
+	// Transform the point to polygon model space
+	Vec2 local = polygon->GetRigidbodyComponent()->GetOrientationMatrix().Transpose() * (point - polygon->GetTransformComponent()->GetWorldPosition());
+
+	float separation = -FLT_MAX;
+	for (int i = 0; i < polygon->VertexCount; ++i)
+		separation = std::max(separation, Dot(polygon->Normals[i], local - polygon->Vertices[i]));
+
+	// Inside the polygon. The least penetrating face is the closest way out
+	if (separation <= 0.0f)
+		return separation;
+
+	// Outside, so the closest feature is on one of the edges
+	float closestSqr = FLT_MAX;
+	for (int i = 0; i < polygon->VertexCount; ++i)
+	{
+		Vec2 v1 = polygon->Vertices[i];
+		Vec2 v2 = polygon->Vertices[i + 1 < polygon->VertexCount ? i + 1 : 0];
+
+		Vec2 edge = v2 - v1;
+		float t = Clamp(0.0f, 1.0f, Dot(local - v1, edge) / std::max(edge.LenSqr(), EPSILON));
+		closestSqr = std::min(closestSqr, (local - (v1 + edge * t)).LenSqr());
+	}
+
+	return std::sqrt(closestSqr);
+}
+
+float CircleTimeOfImpact(float radius, const Vec2 & start, const Vec2 & end, ColliderComponent * collider)
+{
+	Vec2 motion = end - start;
+	float length = motion.Len();
+
+	if (length <= EPSILON || DistanceToCollider(start, collider) <= radius)
+		return 1.0f;
+
+	// Stop just inside the surface so the discrete collision step generates a contact at the impact pose
+	float target = radius - PHYSICS_CCD_SLOP;
+
+	// Conservative advancement. Nothing can close the gap faster than the length of the sweep, so advancing by the gap divided
+	// by the length can never step through the collider
+	float t = 0.0f;
+	for (int i = 0; i < MAX_TOI_ITERATIONS; i++)
+	{
+		float distance = DistanceToCollider(start + motion * t, collider);
+		if (distance <= radius)
+			return t;
+
+		t += (distance - target) / length;
+		if (t >= 1.0f)
+			return 1.0f;
+	}
+
+	// Grazing sweeps converge slowly. Stopping short is still safe as the circle hasn't passed the collider yet
+	return t;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Consts.h"
+#include "ColliderComponent.h"
+
+// Distance from a point to the surface of a collider at its current pose. Negative if the point is inside it
+float DistanceToCollider(const Vec2& point, ColliderComponent* collider);
+
+// Finds the fraction of the sweep, from 0 to 1, at which a circle moving from 'start' to 'end' first touches the collider.
+// The collider is treated as not moving. Returns 1 if the circle never touches it or is already touching it at the start,
+// which the discrete collision step deals with instead
+float CircleTimeOfImpact(float radius, const Vec2& start, const Vec2& end, ColliderComponent* collider);
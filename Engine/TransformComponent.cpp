@@ -1,4 +1,7 @@
 #include "TransformComponent.h"
+#include "TransformHierarchy.h"
+
+#include <algorithm>
 
 // TODO:
 // - Remove world members all together. Although still provide the function to return world values but this is calculated by multiplying local values by parent world values 
@@ -16,6 +19,33 @@ TransformComponent::TransformComponent(Vec2 localPosition, float localRotation,
 	mLocalRotation = localRotation;
 
 	mParent = nullptr;
+	mHierarchy = nullptr;
+	mHierarchyIndex = -1;
+
+	mWorldPosition = localPosition;
+	mWorldRotation = localRotation;
+	mWorldScale = localScale;
+	mWorldDirty = false;
+
+	mPreviousPosition = localPosition;
+	mPreviousRotation = localRotation;
+	mRenderPosition = localPosition;
+	mRenderRotation = localRotation;
+	mInterpolated = false;
+}
+
+TransformComponent::~TransformComponent()
+{
+	SetParent(nullptr);
+
+	for (auto child : mChildren)
+	{
+		child->mParent = nullptr;
+		child->MarkWorldDirty();
+	}
+
+	if (mHierarchy != nullptr)
+		mHierarchy->RemoveTransform(this);
 }
 
 void TransformComponent::SetLocalPosition(Vec2 position)
@@ -23,6 +53,7 @@ void TransformComponent::SetLocalPosition(Vec2 position)
 	if (position.x != mLocalPosition.x || position.y != mLocalPosition.y)
 	{
 		mHasChanged = true;
+		MarkWorldDirty();
 	}
 
 	mLocalPosition = position;
@@ -33,6 +64,7 @@ void TransformComponent::SetLocalScale(float scale)
 	if (scale != mLocalScale)
 	{
 		mHasChanged = true;
+		MarkWorldDirty();
 	}
 
 	mLocalScale = scale;
@@ -43,6 +75,7 @@ void TransformComponent::SetLocalRotation(float rot)
 	if (rot != mLocalRotation)
 	{
 		mHasChanged = true;
+		MarkWorldDirty();
 	}
 
 	mLocalRotation = rot;
@@ -74,7 +107,10 @@ void TransformComponent::SetWorldPosition(Vec2 position)
 
 	// If the new position is different to the old postion set hasChanged to true
 	if (newPos.x != mLocalPosition.x || newPos.y != mLocalPosition.y)
+	{
 		mHasChanged = true;
+		MarkWorldDirty();
+	}
 
 	mLocalPosition = newPos;
 }
@@ -88,7 +124,10 @@ void TransformComponent::SetWorldScale(float scale)
 		newScale = scale;
 
 	if (newScale != mLocalScale)
+	{
 		mHasChanged = true;
+		MarkWorldDirty();
+	}
 
 	mLocalScale = newScale;
 }
@@ -102,31 +141,126 @@ void TransformComponent::SetWorldRotation(float rot)
 		newRot = rot;
 
 	if (newRot != mLocalRotation)
+	{
 		mHasChanged = true;
+		MarkWorldDirty();
+	}
 
 	mLocalRotation = newRot;
 }
 
 float TransformComponent::GetWorldRotation() const
 {
-	if (mParent != nullptr)
-		return mLocalRotation + mParent->GetWorldRotation();
-	else
-		return mLocalRotation;
+	if (mWorldDirty)
+		UpdateWorldTransform();
+
+	return mWorldRotation;
 }
 
 float TransformComponent::GetWorldScale() const
 {
-	if (mParent != nullptr)
-		return mLocalScale * mParent->GetWorldScale();
-	else
-		return mLocalScale;
+	if (mWorldDirty)
+		UpdateWorldTransform();
+
+	return mWorldScale;
 }
 
 Vec2 TransformComponent::GetWorldPosition() const
 {
+	if (mWorldDirty)
+		UpdateWorldTransform();
+
+	return mWorldPosition;
+}
+
+void TransformComponent::SetParent(TransformComponent * parent)
+{
+	if (parent == mParent)
+		return;
+
+	if (mParent != nullptr)
+	{
+		auto& siblings = mParent->mChildren;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+	}
+
+	mParent = parent;
+
 	if (mParent != nullptr)
-		return mLocalPosition + mParent->GetWorldPosition();
+		mParent->mChildren.push_back(this);
+
+	MarkWorldDirty();
+
+	// Children have to stay after their parents in the hierarchy's update order
+	if (mHierarchy != nullptr)
+		mHierarchy->OrderChanged();
+}
+
+void TransformComponent::MarkWorldDirty()
+{
+	if (mWorldDirty)
+		return;
+
+	mWorldDirty = true;
+
+	for (auto child : mChildren)
+		child->MarkWorldDirty();
+}
+
+void TransformComponent::UpdateWorldTransform() const
+{
+	if (mParent != nullptr)
+	{
+		mWorldPosition = mLocalPosition + mParent->GetWorldPosition();
+		mWorldRotation = mLocalRotation + mParent->GetWorldRotation();
+		mWorldScale = mLocalScale * mParent->GetWorldScale();
+	}
+	else
+	{
+		mWorldPosition = mLocalPosition;
+		mWorldRotation = mLocalRotation;
+		mWorldScale = mLocalScale;
+	}
+
+	mWorldDirty = false;
+}
+
+void TransformComponent::StorePreviousPose()
+{
+	mPreviousPosition = GetWorldPosition();
+	mPreviousRotation = GetWorldRotation();
+}
+
+void TransformComponent::ResetInterpolation()
+{
+	StorePreviousPose();
+
+	mRenderPosition = mPreviousPosition;
+	mRenderRotation = mPreviousRotation;
+}
+
+void TransformComponent::Interpolate(float alpha)
+{
+	Vec2 position = GetWorldPosition();
+	float rotation = GetWorldRotation();
+
+	mRenderPosition = mPreviousPosition + (position - mPreviousPosition) * alpha;
+	mRenderRotation = mPreviousRotation + (rotation - mPreviousRotation) * alpha;
+	mInterpolated = true;
+}
+
+Vec2 TransformComponent::GetRenderPosition() const
+{
+	if (mInterpolated)
+		return mRenderPosition;
+	else
+		return GetWorldPosition();
+}
+
+float TransformComponent::GetRenderRotation() const
+{
+	if (mInterpolated)
+		return mRenderRotation;
 	else
-		return mLocalPosition;
+		return GetWorldRotation();
 }
\ No newline at end of file
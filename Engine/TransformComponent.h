@@ -1,12 +1,20 @@
 #pragma once
 
+#include <vector>
+
 #include "IComponent.h"
 #include "Consts.h"
 
+class TransformHierarchy;
+
+// World values are cached and only recalculated after the local values of the transform or one of its ancestors change
 class TransformComponent : public IComponent
 {
+	friend class TransformHierarchy;
+
 public:
 	TransformComponent(Vec2 worldPosition, float worldRotation, float worldScale);
+	~TransformComponent(); // Detaches from the parent, children and hierarchy so none of them are left pointing at it
 
 	void SetLocalPosition(Vec2 position);
 	void SetLocalScale(float scale);
@@ -27,14 +35,43 @@ public:
 	bool CheckChanged() { return mHasChanged; }
 	void SetChanged(bool changed) { mHasChanged = changed; }
 
-	void SetParent(TransformComponent* parent) { mParent = parent; }
+	void SetParent(TransformComponent* parent);
+	TransformComponent* GetParent() const { return mParent; }
+	const std::vector<TransformComponent*>& GetChildren() const { return mChildren; }
+
+	// Drawing happens between two fixed simulation steps, so the pose that is drawn is blended between the last two steps
+	void StorePreviousPose(); // Called at the start of every fixed step
+	void ResetInterpolation(); // Stops the next draw blending from the old pose. Use after teleporting the transform
+	void Interpolate(float alpha); // Sets the render pose. 0 is the previous step, 1 is the current step
+
+	Vec2 GetRenderPosition() const; // Interpolated world position if the scene uses interpolation, otherwise the world position
+	float GetRenderRotation() const;
 
 private:
+	void MarkWorldDirty(); // Flags this transform and every descendant. A dirty transform's descendants are always dirty too, so this stops at the first one already flagged
+	void UpdateWorldTransform() const; // Recalculates the cached world values from the parent's
+
 	Vec2					mLocalPosition;
 	float					mLocalRotation; // RADIANS
 	float					mLocalScale;
 
 	bool					mHasChanged;
 
-	TransformComponent*		mParent;
+	Vec2					mPreviousPosition; // World pose at the start of the last fixed step
+	float					mPreviousRotation;
+	Vec2					mRenderPosition;
+	float					mRenderRotation;
+	bool					mInterpolated;
+
+	// Cached world values. Mutable as they are filled in on demand by the const getters
+	mutable Vec2			mWorldPosition;
+	mutable float			mWorldRotation;
+	mutable float			mWorldScale;
+	mutable bool			mWorldDirty;
+
+	TransformComponent*					mParent;
+	std::vector<TransformComponent*>	mChildren;
+
+	TransformHierarchy*		mHierarchy; // Scene hierarchy this transform is in, if any
+	int						mHierarchyIndex;
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+
+TransformHierarchy::TransformHierarchy()
+{
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+	for (auto transform : mTransforms)
+	{
+		transform->mHierarchy = nullptr;
+		transform->mHierarchyIndex = -1;
+	}
+}
+
+void TransformHierarchy::AddTransform(TransformComponent * transform)
+{
+	if (transform->mHierarchy == this)
+		return;
+
+	if (transform->mHierarchy != nullptr)
+		throw std::exception("This transform is already in another scene's hierarchy.");
+
+	transform->mHierarchy = this;
+	transform->mHierarchyIndex = (int)mTransforms.size();
+	mTransforms.push_back(transform);
+
+	mOrderDirty = true;
+}
+
+void TransformHierarchy::RemoveTransform(TransformComponent * transform)
+{
+	if (transform->mHierarchy != this)
+		return;
+
+	int index = transform->mHierarchyIndex;
+	mTransforms[index] = mTransforms.back();
+	mTransforms[index]->mHierarchyIndex = index;
+	mTransforms.pop_back();
+
+	transform->mHierarchy = nullptr;
+	transform->mHierarchyIndex = -1;
+
+	mOrderDirty = true;
+}
+
+void TransformHierarchy::Update()
+{
+	if (mOrderDirty)
+		SortByDepth();
+
+	// Parents come first so by the time a child is reached its parent's world values are already up to date
+	mLastUpdateCount = 0;
+	for (auto transform : mTransforms)
+	{
+		if (transform->mWorldDirty)
+		{
+			transform->UpdateWorldTransform();
+			mLastUpdateCount++;
+		}
+	}
+}
+
+void TransformHierarchy::SortByDepth()
+{
+	// Sorting by depth is enough to put every parent before its children. Sorted indirectly through the
+	// old indices so each depth is only worked out once
+	mDepths.resize(mTransforms.size());
+	std::vector<int> order(mTransforms.size());
+	for (int i = 0; i < mTransforms.size(); i++)
+	{
+		int depth = 0;
+		for (TransformComponent* parent = mTransforms[i]->mParent; parent != nullptr; parent = parent->mParent)
+			depth++;
+
+		mDepths[i] = depth;
+		order[i] = i;
+	}
+
+	// Stable so transforms at the same depth keep the order they were added in
+	std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return mDepths[a] < mDepths[b]; });
+
+	std::vector<TransformComponent*> sorted(mTransforms.size());
+	for (int i = 0; i < order.size(); i++)
+	{
+		sorted[i] = mTransforms[order[i]];
+		sorted[i]->mHierarchyIndex = i;
+	}
+
+	mTransforms.swap(sorted);
+	mOrderDirty = false;
+}
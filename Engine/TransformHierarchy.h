@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "TransformComponent.h"
+
+// Flat list of every transform in a scene with parents always before their children, so resolving the
+// whole scene's world transforms is a single pass that calculates each dirty transform exactly once
+class TransformHierarchy
+{
+public:
+	TransformHierarchy();
+	~TransformHierarchy(); // Detaches every transform still in the hierarchy
+
+	void AddTransform(TransformComponent* transform);
+	void RemoveTransform(TransformComponent* transform);
+	void OrderChanged() { mOrderDirty = true; } // Called when a transform is reparented. The list is sorted again before the next update
+
+	void Update(); // Recalculates the world values of every dirty transform
+
+	int GetTransformCount() const { return (int)mTransforms.size(); }
+	int GetLastUpdateCount() const { return mLastUpdateCount; } // Number of transforms recalculated by the last update
+
+private:
+	void SortByDepth();
+
+	std::vector<TransformComponent*>	mTransforms;
+	std::vector<int>					mDepths; // Only used while sorting. Kept so the storage is reused
+	bool								mOrderDirty = false;
+	int									mLastUpdateCount = 0;
+};
@@ -12,19 +12,18 @@ TriggerBoxComponent::~TriggerBoxComponent()
 {
 }
 
-void TriggerBoxComponent::RecieveMessage(IMessage & msg)
+void TriggerBoxComponent::SubscribeToCollisions(CollisionEventQueue & events, ColliderComponent * collider)
 {
-	switch (msg.GetType())
+	if (collider == nullptr)
 	{
-		case MessageType::eCollision:
-		{
-			CollisionMessage& colMsg = static_cast<CollisionMessage &> (msg);
-			if (colMsg.CollidedObject->GetTag() == mTriggerTag)
-			{
-				mIsTriggered = true;
-			}
-
-			break;
-		}
+		throw std::exception("This object requires a collider component.");
 	}
+
+	events.Subscribe(collider, this, mTriggerTag, eCollisionBegin);
+}
+
+void TriggerBoxComponent::RecieveCollisionEvent(const CollisionEvent & event)
+{
+	// Only subscribed to objects with the trigger tag starting to touch
+	mIsTriggered = true;
 }
\ No newline at end of file
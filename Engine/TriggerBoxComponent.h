@@ -1,18 +1,19 @@
 #pragma once
 
 #include "IComponent.h"
-#include "IMessageable.h"
+#include "ICollisionListener.h"
 #include "IUpdateable.h"
 
-#include "CollisionMessage.h"
+#include "CollisionEventQueue.h"
 
-class TriggerBoxComponent :	public IComponent, public IMessageable
+class TriggerBoxComponent :	public IComponent, public ICollisionListener
 {
 public:
 	TriggerBoxComponent(std::string triggerTag);
 	~TriggerBoxComponent();
 
-	virtual void RecieveMessage(IMessage &msg) override;
+	virtual void SubscribeToCollisions(CollisionEventQueue& events, ColliderComponent* collider) override;
+	virtual void RecieveCollisionEvent(const CollisionEvent& event) override;
 
 	bool IsTriggered() { return mIsTriggered; }
 	bool& GetTriggeredReference() { return mIsTriggered; }
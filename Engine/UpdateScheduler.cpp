@@ -0,0 +1,169 @@
+#include "UpdateScheduler.h"
+#include "JobSystem.h"
+
+UpdateScheduler::~UpdateScheduler()
+{
+	// Objects can outlive the scene, so make sure nothing tries to tell it about changes
+	for (auto& slot : mSlots)
+		slot.first->SetActivationListener(nullptr);
+}
+
+void UpdateScheduler::AddGameObject(shared_ptr<GameObject> gameObject)
+{
+	for (auto& entry : gameObject->GetUpdateableComponents())
+		AddComponent(entry.component, entry.capability);
+}
+
+void UpdateScheduler::AddComponent(IComponent * component, IUpdateable * updateable)
+{
+	if (mSlots.find(component) != mSlots.end())
+		return;
+
+	UpdateSlot slot;
+	slot.updateable = updateable;
+	slot.list = FindOrCreateList(component, updateable);
+	slot.index = -1;
+	mSlots[component] = slot;
+
+	component->SetActivationListener(this);
+	RefreshSlot(component);
+}
+
+void UpdateScheduler::RemoveComponent(IComponent * component)
+{
+	if (mUpdating)
+		throw std::exception("Components can't be removed from the scheduler while it is updating.");
+
+	auto it = mSlots.find(component);
+	if (it == mSlots.end())
+		return;
+
+	UpdateSlot& slot = it->second;
+	if (slot.index != -1)
+	{
+		// Swap the last component into the gap
+		auto& components = mLists[slot.list].components;
+		components[slot.index] = components.back();
+		mSlots[components[slot.index].component].index = slot.index;
+		components.pop_back();
+	}
+
+	component->SetActivationListener(nullptr);
+	mSlots.erase(it);
+}
+
+void UpdateScheduler::BeginStep()
+{
+	mUpdating = true;
+}
+
+void UpdateScheduler::UpdateParallel(UpdateThreading threading, float deltaTime)
+{
+	for (auto& list : mLists)
+	{
+		if (list.threading != threading)
+			continue;
+
+		auto& components = list.components;
+		JobSystem::Instance().ParallelFor((int)components.size(), UPDATE_PARALLEL_GRAIN_SIZE, [&components, deltaTime](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				if (components[i].component->GetActive())
+					components[i].capability->Update(deltaTime);
+			}
+		});
+	}
+}
+
+void UpdateScheduler::Update(float deltaTime)
+{
+	mUpdating = true;
+
+	for (int listIndex : mListOrder)
+	{
+		if (mLists[listIndex].threading != eUpdateSerial)
+			continue;
+
+		// Indexed rather than iterated as components can still be added to the list. They wait until the next frame
+		auto& components = mLists[listIndex].components;
+		int count = (int)components.size();
+		for (int i = 0; i < count; i++)
+		{
+			// Anything deactivated earlier this frame stays in the list until the end of the update, but shouldn't run
+			if (components[i].component->GetActive())
+				components[i].capability->Update(deltaTime);
+		}
+	}
+
+	mUpdating = false;
+
+	for (auto component : mPendingChanges)
+		RefreshSlot(component);
+
+	mPendingChanges.clear();
+}
+
+void UpdateScheduler::ComponentActiveChanged(IComponent * component)
+{
+	if (mUpdating)
+		mPendingChanges.push_back(component);
+	else
+		RefreshSlot(component);
+}
+
+int UpdateScheduler::GetActiveComponentCount() const
+{
+	int count = 0;
+	for (auto& list : mLists)
+		count += (int)list.components.size();
+
+	return count;
+}
+
+int UpdateScheduler::FindOrCreateList(IComponent * component, IUpdateable * updateable)
+{
+	type_index type = typeid(*component);
+
+	auto it = mListIndices.find(type);
+	if (it != mListIndices.end())
+		return it->second;
+
+	int listIndex = (int)mLists.size();
+	mListIndices[type] = listIndex;
+
+	UpdateList list;
+	list.order = updateable->GetUpdateOrder();
+	list.threading = updateable->GetUpdateThreading();
+	mLists.push_back(list);
+
+	// Stable so types with the same order keep the order they were added in
+	mListOrder.push_back(listIndex);
+	std::stable_sort(mListOrder.begin(), mListOrder.end(), [this](int a, int b) { return mLists[a].order < mLists[b].order; });
+
+	return listIndex;
+}
+
+void UpdateScheduler::RefreshSlot(IComponent * component)
+{
+	auto it = mSlots.find(component);
+	if (it == mSlots.end())
+		return;
+
+	UpdateSlot& slot = it->second;
+	auto& components = mLists[slot.list].components;
+
+	if (component->GetActive() && slot.index == -1)
+	{
+		slot.index = (int)components.size();
+		components.push_back({ component, slot.updateable });
+	}
+	else if (!component->GetActive() && slot.index != -1)
+	{
+		// Swap the last component into the gap
+		components[slot.index] = components.back();
+		mSlots[components[slot.index].component].index = slot.index;
+		components.pop_back();
+		slot.index = -1;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <typeindex>
+#include <vector>
+
+#include "GameObject.h"
+
+// Keeps the active updateable components of each type in their own list and updates the lists one after another in UpdateOrder.
+// Inactive components aren't in any list, so a frame only costs as much as the components that are actually running.
+class UpdateScheduler : public IActivationListener
+{
+public:
+	~UpdateScheduler();
+
+	void AddGameObject(shared_ptr<GameObject> gameObject); // Adds every updateable component on the object. Not its children
+	void AddComponent(IComponent* component, IUpdateable* updateable);
+	void RemoveComponent(IComponent* component); // Can't be called while updating
+
+	void BeginStep(); // Defers activation changes until Update finishes, so no list changes while jobs are updating it
+	void UpdateParallel(UpdateThreading threading, float deltaTime); // Updates every type with this threading, split over the job system. Safe to run alongside other jobs between BeginStep and Update
+	void Update(float deltaTime); // Updates the serial types in UpdateOrder, then applies any deferred activation changes
+
+	virtual void ComponentActiveChanged(IComponent* component) override;
+
+	int GetActiveComponentCount() const;
+
+private:
+	struct UpdateList
+	{
+		UpdateOrder										order;
+		UpdateThreading									threading;
+		vector<ComponentCapabilityEntry<IUpdateable>>	components;
+	};
+
+	struct UpdateSlot
+	{
+		IUpdateable*	updateable;
+		int				list;
+		int				index; // Position in the list. -1 while inactive
+	};
+
+	int FindOrCreateList(IComponent* component, IUpdateable* updateable);
+	void RefreshSlot(IComponent* component); // Adds the component to its list, or removes it, to match whether it is active
+
+	vector<UpdateList>							mLists;
+	vector<int>									mListOrder; // Index into mLists in the order they are updated
+	map<type_index, int>						mListIndices;
+
+	unordered_map<IComponent*, UpdateSlot>		mSlots;
+
+	bool										mUpdating = false;
+	vector<IComponent*>							mPendingChanges; // Components activated or deactivated during Update. Applied once every list has finished
+};